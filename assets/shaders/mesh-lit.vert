@@ -3,18 +3,25 @@
 layout (location = 0) in vec3 aPosition;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aUv;
+layout (location = 3) in mat4 aModel;
+layout (location = 7) in mat3 aNormalMatrix;
 
 out vec3 Normal;
 out vec2 Uv;
 out vec3 Position;
 
-uniform mat4 u_mvp;
-uniform mat4 u_model;
-uniform mat3 u_normal;
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 position;
+} u_camera;
 
 void main() {
-    gl_Position = u_mvp * vec4(aPosition, 1.0);
+    vec4 worldPosition = aModel * vec4(aPosition, 1.0);
+
+    gl_Position = u_camera.viewProjection * worldPosition;
     Uv = aUv;
-    Normal = u_normal * aNormal;
-    Position = vec3(u_model * vec4(aPosition, 1.0));
+    Normal = aNormalMatrix * aNormal;
+    Position = vec3(worldPosition);
 }
@@ -0,0 +1,50 @@
+#include <renderer/model-cache.h>
+#include <renderer/model-cooker.h>
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @brief Cooks a model and writes its cache next to the source file.
+ *
+ * Geometry is cooked in model space, the way ModelStore loads it
+ * for every scale variant.
+ */
+static void cookModelCache(const std::filesystem::path& path) {
+    const glm::mat4 transform{ 1.f };
+
+    const auto startTime{ std::chrono::steady_clock::now() };
+    const CookedModel cookedModel{ cookModel(path, transform) };
+    ModelCache::write(path, transform, cookedModel);
+    const std::chrono::duration<double, std::milli> elapsed{ std::chrono::steady_clock::now() - startTime };
+
+    std::cout << std::format("Cooked {} ({} meshes) into {} in {:.1f} ms\n",
+        path.generic_string(),
+        cookedModel.meshes.size(),
+        ModelCache::getCachePath(path, transform).generic_string(),
+        elapsed.count());
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: cook-models <model>...\n";
+        return -1;
+    }
+
+    int returnValue{ 0 };
+    for (int i{ 1 }; i < argc; ++i) {
+        try {
+            cookModelCache(argv[i]);
+        } catch (const std::exception& exception) {
+            std::cerr << std::format("Failed to cook {}: {}\n", argv[i], exception.what());
+            returnValue = -1;
+        }
+    }
+
+    return returnValue;
+}
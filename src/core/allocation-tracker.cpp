@@ -0,0 +1,284 @@
+#include "allocation-tracker.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace {
+    /**
+     * @brief Spin lock guarding the zone tables, constant-initialized so it works before main().
+     */
+    class SpinLock {
+    public:
+        void lock() noexcept {
+            while (m_flag.test_and_set(std::memory_order_acquire)) {
+                m_flag.wait(true, std::memory_order_relaxed);
+            }
+        }
+
+        void unlock() noexcept {
+            m_flag.clear(std::memory_order_release);
+            m_flag.notify_one();
+        }
+
+    private:
+        std::atomic_flag m_flag{};
+    };
+
+    void add(AllocationCounts& counts, const AllocationCounts& added) noexcept {
+        counts.count += added.count;
+        counts.bytes += added.bytes;
+    }
+
+    /**
+     * @brief Returns whether two zone names are equal, equal literals may have different addresses.
+     */
+    bool isSameZone(const char* const lhs, const char* const rhs) noexcept {
+        return lhs == rhs || (lhs && rhs && std::strcmp(lhs, rhs) == 0);
+    }
+
+    /**
+     * @brief Counts per zone name in a fixed-size array.
+     */
+    struct ZoneTable {
+        void charge(const char* const name, const AllocationCounts& counts) noexcept {
+            const auto end{ zones.begin() + size };
+            auto it{ std::ranges::find_if(zones.begin(), end, [name](const AllocationTracker::ZoneCounts& zone) {
+                return isSameZone(zone.name, name);
+            }) };
+
+            if (it == end) {
+                if (size == zones.size()) {
+                    add(dropped, counts);
+                    return;
+                }
+                it->name = name;
+                ++size;
+            }
+
+            add(it->counts, counts);
+        }
+
+        void clear() noexcept {
+            size = 0;
+            dropped = {};
+        }
+
+        std::size_t copySorted(const std::span<AllocationTracker::ZoneCounts> destination) const noexcept {
+            const std::size_t count{ std::min(size, destination.size()) };
+            std::ranges::partial_sort_copy(zones.begin(), zones.begin() + size, destination.begin(), destination.begin() + count,
+                std::ranges::greater{}, [](const AllocationTracker::ZoneCounts& zone) { return zone.counts.count; },
+                [](const AllocationTracker::ZoneCounts& zone) { return zone.counts.count; });
+            return count;
+        }
+
+        std::array<AllocationTracker::ZoneCounts, AllocationTracker::maxZoneCount> zones{};
+        std::size_t size{};
+        AllocationCounts dropped{};
+    };
+
+    constinit std::atomic<std::uint64_t> g_totalCount{};
+    constinit std::atomic<std::uint64_t> g_totalBytes{};
+    constinit std::atomic<bool> g_areAllocationsForbidden{};
+
+    constinit SpinLock g_lock{};
+    constinit ZoneTable g_frameZones{};
+    constinit ZoneTable g_latestFrameZones{};
+    constinit ZoneTable g_violations{};
+    constinit AllocationCounts g_violationCounts{};
+
+    // Only touched by the thread marking frames.
+    constinit AllocationCounts g_frameStart{};
+    constinit AllocationCounts g_latestFrame{};
+
+    constinit thread_local AllocationCounts t_counts{};
+    constinit thread_local const char* t_zone{};
+    /// Allocations of the finished zones nested directly in the innermost one.
+    constinit thread_local AllocationCounts t_nestedCounts{};
+}
+
+void AllocationTracker::recordAllocation(const std::size_t size) noexcept {
+    ++t_counts.count;
+    t_counts.bytes += size;
+
+    g_totalCount.fetch_add(1, std::memory_order_relaxed);
+    g_totalBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (g_areAllocationsForbidden.load(std::memory_order_relaxed)) {
+        const std::lock_guard lock{ g_lock };
+        g_violations.charge(t_zone, { 1, size });
+        add(g_violationCounts, { 1, size });
+    }
+}
+
+AllocationCounts AllocationTracker::getThreadCounts() noexcept {
+    return t_counts;
+}
+
+AllocationCounts AllocationTracker::getTotalCounts() noexcept {
+    return {
+        .count{ g_totalCount.load(std::memory_order_relaxed) },
+        .bytes{ g_totalBytes.load(std::memory_order_relaxed) },
+    };
+}
+
+AllocationTracker::ZoneState AllocationTracker::enterZone(const char* const name) noexcept {
+    const ZoneState state{
+        .previousZone{ std::exchange(t_zone, name) },
+        .countsAtStart{ t_counts },
+        .previousNestedCounts{ std::exchange(t_nestedCounts, {}) },
+    };
+    return state;
+}
+
+void AllocationTracker::leaveZone(const char* const name, const ZoneState& state) noexcept {
+    const AllocationCounts inclusive{
+        t_counts.count - state.countsAtStart.count,
+        t_counts.bytes - state.countsAtStart.bytes,
+    };
+    const AllocationCounts self{
+        inclusive.count - t_nestedCounts.count,
+        inclusive.bytes - t_nestedCounts.bytes,
+    };
+
+    t_zone = state.previousZone;
+    t_nestedCounts = state.previousNestedCounts;
+    add(t_nestedCounts, inclusive);
+
+    if (self.count == 0) {
+        return;
+    }
+
+    const std::lock_guard lock{ g_lock };
+    g_frameZones.charge(name, self);
+}
+
+void AllocationTracker::markFrame() noexcept {
+    const AllocationCounts total{ getTotalCounts() };
+    g_latestFrame = { total.count - g_frameStart.count, total.bytes - g_frameStart.bytes };
+    g_frameStart = total;
+
+    const std::lock_guard lock{ g_lock };
+    g_latestFrameZones = g_frameZones;
+    g_frameZones.clear();
+}
+
+AllocationCounts AllocationTracker::getFrameCounts() noexcept {
+    return g_latestFrame;
+}
+
+AllocationCounts AllocationTracker::getDroppedFrameCounts() noexcept {
+    const std::lock_guard lock{ g_lock };
+    return g_latestFrameZones.dropped;
+}
+
+std::size_t AllocationTracker::copyFrameZones(const std::span<ZoneCounts> zones) noexcept {
+    const std::lock_guard lock{ g_lock };
+    return g_latestFrameZones.copySorted(zones);
+}
+
+void AllocationTracker::setAllocationsForbidden(const bool isForbidden) noexcept {
+    g_areAllocationsForbidden.store(isForbidden, std::memory_order_relaxed);
+}
+
+bool AllocationTracker::areAllocationsForbidden() noexcept {
+    return g_areAllocationsForbidden.load(std::memory_order_relaxed);
+}
+
+std::size_t AllocationTracker::copyViolations(const std::span<ZoneCounts> zones) noexcept {
+    const std::lock_guard lock{ g_lock };
+    return g_violations.copySorted(zones);
+}
+
+AllocationCounts AllocationTracker::getDroppedViolationCounts() noexcept {
+    const std::lock_guard lock{ g_lock };
+    return g_violations.dropped;
+}
+
+AllocationCounts AllocationTracker::getViolationCounts() noexcept {
+    const std::lock_guard lock{ g_lock };
+    return g_violationCounts;
+}
+
+#ifdef ENABLE_ALLOCATION_TRACKING
+
+// Replacing the global allocation functions here links them in along with the tracker.
+
+namespace {
+    void* allocate(const std::size_t size) noexcept {
+        void* const pointer{ std::malloc(size ? size : 1) };
+        if (pointer) {
+            AllocationTracker::recordAllocation(size);
+        }
+        return pointer;
+    }
+
+    void* allocateAligned(const std::size_t size, const std::align_val_t alignment) noexcept {
+        const auto alignmentValue{ static_cast<std::size_t>(alignment) };
+#ifdef _WIN32
+        void* const pointer{ _aligned_malloc(size ? size : 1, alignmentValue) };
+#else
+        // The size of aligned_alloc() has to be a multiple of the alignment.
+        void* const pointer{ std::aligned_alloc(alignmentValue, (std::max(size, std::size_t{ 1 }) + alignmentValue - 1) / alignmentValue * alignmentValue) };
+#endif // _WIN32
+        if (pointer) {
+            AllocationTracker::recordAllocation(size);
+        }
+        return pointer;
+    }
+
+    void deallocateAligned(void* const pointer) noexcept {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif // _WIN32
+    }
+
+    void* allocateOrThrow(const std::size_t size) {
+        void* const pointer{ allocate(size) };
+        if (!pointer) {
+            throw std::bad_alloc{};
+        }
+        return pointer;
+    }
+
+    void* allocateAlignedOrThrow(const std::size_t size, const std::align_val_t alignment) {
+        void* const pointer{ allocateAligned(size, alignment) };
+        if (!pointer) {
+            throw std::bad_alloc{};
+        }
+        return pointer;
+    }
+}
+
+void* operator new(const std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](const std::size_t size) { return allocateOrThrow(size); }
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](const std::size_t size, const std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+
+void operator delete(void* const pointer) noexcept { std::free(pointer); }
+void operator delete[](void* const pointer) noexcept { std::free(pointer); }
+void operator delete(void* const pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* const pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* const pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* const pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+void operator delete(void* const pointer, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete[](void* const pointer, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete(void* const pointer, std::size_t, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete[](void* const pointer, std::size_t, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete(void* const pointer, std::align_val_t, const std::nothrow_t&) noexcept { deallocateAligned(pointer); }
+void operator delete[](void* const pointer, std::align_val_t, const std::nothrow_t&) noexcept { deallocateAligned(pointer); }
+
+#endif // ENABLE_ALLOCATION_TRACKING
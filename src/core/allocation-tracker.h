@@ -0,0 +1,143 @@
+#pragma once
+
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Allocations and allocated bytes.
+ */
+struct AllocationCounts {
+    std::uint64_t count{};
+    std::uint64_t bytes{};
+};
+
+/**
+ * @brief Process-wide counter of heap allocations.
+ *
+ * Building with ENABLE_ALLOCATION_TRACKING replaces the global allocation
+ * functions, which then count every allocation of every thread. Without it
+ * nothing is counted and every query returns zeros.
+ *
+ * Allocations are also charged to the innermost PROFILE_ZONE of the
+ * allocating thread, excluding those of nested zones, in a per-frame table
+ * of a fixed size, so charging never allocates itself. Zones are matched
+ * by name, so equal literals of different translation units share a row.
+ * Allocations of zones not fitting in a full table are counted as dropped.
+ *
+ * While allocations are forbidden, each one is flagged as a violation
+ * of the innermost zone instead of failing, so a single run collects
+ * every offender. Violations are kept until the end of the process.
+ */
+class AllocationTracker {
+public:
+    /**
+     * @brief Counts charged to a zone.
+     */
+    struct ZoneCounts {
+        const char* name{}; ///< Zone name, null for allocations outside of any zone
+        AllocationCounts counts{};
+    };
+
+    /**
+     * @brief State of the enclosing zone saved by enterZone().
+     */
+    struct ZoneState {
+        const char* previousZone{};
+        AllocationCounts countsAtStart{};
+        AllocationCounts previousNestedCounts{};
+    };
+
+    /**
+     * @brief Number of distinct zones kept per table, further zones are counted as dropped.
+     */
+    static constexpr std::size_t maxZoneCount{ 64 };
+
+#ifdef ENABLE_ALLOCATION_TRACKING
+    static constexpr bool isEnabled{ true };
+#else
+    static constexpr bool isEnabled{ false };
+#endif // ENABLE_ALLOCATION_TRACKING
+
+    AllocationTracker() = delete;
+
+    /**
+     * @brief Counts an allocation, called by the replaced allocation functions.
+     */
+    static void recordAllocation(const std::size_t size) noexcept;
+
+    /**
+     * @brief Returns the allocations of the calling thread since it started.
+     */
+    [[nodiscard]] static AllocationCounts getThreadCounts() noexcept;
+
+    /**
+     * @brief Returns the allocations of every thread since the process started.
+     */
+    [[nodiscard]] static AllocationCounts getTotalCounts() noexcept;
+
+    /**
+     * @brief Makes a zone the innermost zone of the calling thread.
+     *
+     * @return State of the enclosing zone, to be restored by leaveZone().
+     */
+    [[nodiscard]] static ZoneState enterZone(const char* const name) noexcept;
+
+    /**
+     * @brief Charges the allocations since enterZone(), without those of nested zones,
+     *        to the zone and restores the enclosing one.
+     *
+     * @param name Zone being left.
+     * @param state Value returned by enterZone().
+     */
+    static void leaveZone(const char* const name, const ZoneState& state) noexcept;
+
+    /**
+     * @brief Ends the frame, making its counts available through the getters of the latest frame.
+     *
+     * Should be called once at the beginning of every frame.
+     */
+    static void markFrame() noexcept;
+
+    /**
+     * @brief Returns the allocations of every thread during the latest frame.
+     */
+    [[nodiscard]] static AllocationCounts getFrameCounts() noexcept;
+
+    /**
+     * @brief Copies the zones which allocated during the latest frame, most allocations first.
+     *
+     * @return Number of copied zones.
+     */
+    static std::size_t copyFrameZones(const std::span<ZoneCounts> zones) noexcept;
+
+    /**
+     * @brief Returns the allocations of the latest frame charged to no zone because the table was full.
+     */
+    [[nodiscard]] static AllocationCounts getDroppedFrameCounts() noexcept;
+
+    static void setAllocationsForbidden(const bool isForbidden) noexcept;
+    [[nodiscard]] static bool areAllocationsForbidden() noexcept;
+
+    /**
+     * @brief Copies the zones which allocated while allocations were forbidden, most allocations first.
+     *
+     * @return Number of copied zones.
+     */
+    static std::size_t copyViolations(const std::span<ZoneCounts> zones) noexcept;
+
+    /**
+     * @brief Returns the violations charged to no zone because the table was full.
+     */
+    [[nodiscard]] static AllocationCounts getDroppedViolationCounts() noexcept;
+
+    /**
+     * @brief Returns the allocations made while allocations were forbidden.
+     */
+    [[nodiscard]] static AllocationCounts getViolationCounts() noexcept;
+};
+
+#endif // ALLOCATION_TRACKER_H
@@ -0,0 +1,124 @@
+#include "batch-math.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BATCH_MATH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(BATCH_MATH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_MATH_TARGET(isa) __attribute__((target(isa)))
+#else
+#define BATCH_MATH_TARGET(isa)
+#endif
+
+static void multiplyAddScalar(float* const values, const float* const deltas, const std::size_t count, const float factor) noexcept {
+    for (std::size_t i{}; i < count; ++i) {
+        values[i] += deltas[i] * factor;
+    }
+}
+
+#ifdef BATCH_MATH_X86
+BATCH_MATH_TARGET("sse2")
+static void multiplyAddSse2(float* const values, const float* const deltas, const std::size_t count, const float factor) noexcept {
+    const __m128 scale{ _mm_set1_ps(factor) };
+    std::size_t i{};
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 scaled{ _mm_mul_ps(_mm_loadu_ps(deltas + i), scale) };
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), scaled));
+    }
+
+    multiplyAddScalar(values + i, deltas + i, count - i, factor);
+}
+
+BATCH_MATH_TARGET("avx2")
+static void multiplyAddAvx2(float* const values, const float* const deltas, const std::size_t count, const float factor) noexcept {
+    const __m256 scale{ _mm256_set1_ps(factor) };
+    std::size_t i{};
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 scaled{ _mm256_mul_ps(_mm256_loadu_ps(deltas + i), scale) };
+        _mm256_storeu_ps(values + i, _mm256_add_ps(_mm256_loadu_ps(values + i), scaled));
+    }
+
+    multiplyAddSse2(values + i, deltas + i, count - i, factor);
+}
+#endif
+
+static SimdLevel detectSimdLevel() noexcept {
+#if defined(BATCH_MATH_X86) && defined(_MSC_VER) && !defined(__clang__)
+    int registers[4]{};
+    __cpuid(registers, 1);
+    const bool hasOsSaveSupport{ (registers[2] & (1 << 27)) != 0 };
+    const bool hasSse2{ (registers[3] & (1 << 26)) != 0 };
+
+    __cpuidex(registers, 7, 0);
+    const bool hasAvx2{ (registers[1] & (1 << 5)) != 0 };
+
+    // The OS has to save the YMM registers on context switches.
+    if (hasAvx2 && hasOsSaveSupport && (_xgetbv(0) & 0x6) == 0x6) {
+        return SimdLevel::Avx2;
+    }
+    return hasSse2 ? SimdLevel::Sse2 : SimdLevel::Scalar;
+#elif defined(BATCH_MATH_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::Avx2;
+    }
+    return __builtin_cpu_supports("sse2") ? SimdLevel::Sse2 : SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel getSimdLevel() noexcept {
+    static const SimdLevel level{ detectSimdLevel() };
+    return level;
+}
+
+std::string_view getSimdLevelName(const SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::Avx2:
+        return "AVX2";
+    case SimdLevel::Sse2:
+        return "SSE2";
+    case SimdLevel::Scalar:
+    default:
+        return "scalar";
+    }
+}
+
+void multiplyAdd(std::span<float> values, std::span<const float> deltas, const float factor) noexcept {
+    multiplyAdd(getSimdLevel(), values, deltas, factor);
+}
+
+void multiplyAdd(
+    const SimdLevel level,
+    std::span<float> values,
+    std::span<const float> deltas,
+    const float factor
+) noexcept {
+    const std::size_t count{ std::min(values.size(), deltas.size()) };
+    const SimdLevel supportedLevel{ std::min(level, getSimdLevel()) };
+
+    switch (supportedLevel) {
+#ifdef BATCH_MATH_X86
+    case SimdLevel::Avx2:
+        multiplyAddAvx2(values.data(), deltas.data(), count, factor);
+        break;
+    case SimdLevel::Sse2:
+        multiplyAddSse2(values.data(), deltas.data(), count, factor);
+        break;
+#endif
+    case SimdLevel::Scalar:
+    default:
+        multiplyAddScalar(values.data(), deltas.data(), count, factor);
+        break;
+    }
+}
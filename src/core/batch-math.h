@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef BATCH_MATH_H
+#define BATCH_MATH_H
+
+#include <span>
+#include <string_view>
+
+/**
+ * @brief Instruction set used by the batch kernels.
+ */
+enum class SimdLevel {
+    Scalar, ///< Portable fallback
+    Sse2,   ///< 4 floats per instruction, baseline on x86-64
+    Avx2    ///< 8 floats per instruction
+};
+
+/**
+ * @brief Returns the best instruction set supported by the CPU and the OS.
+ *
+ * Detected once, on first use.
+ */
+[[nodiscard]] SimdLevel getSimdLevel() noexcept;
+
+[[nodiscard]] std::string_view getSimdLevelName(const SimdLevel level) noexcept;
+
+/**
+ * @brief Computes values[i] += deltas[i] * factor for every element.
+ *
+ * Uses the kernel of getSimdLevel(). Every level multiplies and adds
+ * separately instead of using fused multiply-add, so all of them produce
+ * bit-identical results and the simulation stays reproducible across CPUs.
+ *
+ * @param values Values to update, at most as many as there are deltas.
+ * @param deltas Increments, scaled by the factor.
+ * @param factor Scale of the increments.
+ */
+void multiplyAdd(std::span<float> values, std::span<const float> deltas, const float factor) noexcept;
+
+/**
+ * @brief Computes values[i] += deltas[i] * factor using a given kernel.
+ *
+ * Levels the CPU does not support fall back to the best supported one.
+ */
+void multiplyAdd(
+    const SimdLevel level,
+    std::span<float> values,
+    std::span<const float> deltas,
+    const float factor
+) noexcept;
+
+#endif // BATCH_MATH_H
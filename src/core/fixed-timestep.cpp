@@ -0,0 +1,23 @@
+#include "fixed-timestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+FixedTimestep::FixedTimestep(const double stepSize, const std::size_t maxStepsPerFrame) noexcept
+    : m_stepSize        { stepSize > 0.0 ? stepSize : 1.0 / 60.0 }
+    , m_maxStepsPerFrame{ std::max<std::size_t>(maxStepsPerFrame, 1) }
+{}
+
+std::size_t FixedTimestep::advance(const double dt) noexcept {
+    m_accumulatedTime += std::max(dt, 0.0);
+
+    const auto stepCount{ static_cast<std::size_t>(m_accumulatedTime / m_stepSize) };
+    if (stepCount <= m_maxStepsPerFrame) {
+        m_accumulatedTime = std::max(m_accumulatedTime - stepCount * m_stepSize, 0.0);
+        return stepCount;
+    }
+
+    m_droppedSteps += stepCount - m_maxStepsPerFrame;
+    m_accumulatedTime = std::fmod(m_accumulatedTime, m_stepSize);
+    return m_maxStepsPerFrame;
+}
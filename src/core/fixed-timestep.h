@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include <cstddef>
+
+/**
+ * @brief Accumulator that decouples the simulation rate from the frame rate.
+ *
+ * Frame time is accumulated and consumed in steps of a fixed size.
+ * The time left over after the last step is exposed as an interpolation
+ * factor, so rendering can blend between the two latest simulation states.
+ */
+class FixedTimestep {
+public:
+    /**
+     * @brief Constructs the accumulator.
+     *
+     * @param stepSize Duration of a single simulation step in seconds.
+     * @param maxStepsPerFrame Upper limit of steps run in a single frame,
+     *        time exceeding it is dropped so that one long frame cannot
+     *        cause an ever growing backlog of steps.
+     */
+    FixedTimestep(const double stepSize, const std::size_t maxStepsPerFrame) noexcept;
+
+    /**
+     * @brief Accumulates frame time and returns how many steps should be simulated.
+     *
+     * Should be called once per frame.
+     *
+     * @param dt Time delta in seconds since the last frame.
+     * @return Number of fixed steps to run this frame.
+     */
+    [[nodiscard]] std::size_t advance(const double dt) noexcept;
+
+    /**
+     * @brief Returns the fraction of a step left in the accumulator, in the range [0, 1).
+     */
+    [[nodiscard]] double getAlpha() const noexcept {
+        return m_accumulatedTime / m_stepSize;
+    }
+
+    [[nodiscard]] double getStepSize() const noexcept { return m_stepSize; }
+    [[nodiscard]] std::size_t getMaxStepsPerFrame() const noexcept { return m_maxStepsPerFrame; }
+
+    /**
+     * @brief Returns the number of steps dropped so far because of the per frame limit.
+     */
+    [[nodiscard]] std::size_t getDroppedSteps() const noexcept { return m_droppedSteps; }
+
+private:
+    double m_stepSize{};
+    double m_accumulatedTime{};
+    std::size_t m_maxStepsPerFrame{};
+    std::size_t m_droppedSteps{};
+};
+
+#endif // FIXED_TIMESTEP_H
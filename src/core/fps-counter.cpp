@@ -1,6 +1,31 @@
 #include "fps-counter.h"
 
-void FpsCounter::update(const double dt) noexcept {
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+FpsCounter::FpsCounter() {
+    m_frameTimes.reserve(windowSize);
+    m_sortedFrameTimes.reserve(windowSize);
+}
+
+void FpsCounter::update(const double dt) {
+    const auto frameTime{ static_cast<float>(dt * 1000.0) };
+
+    if (m_frameTimes.size() < windowSize) {
+        m_frameTimes.push_back(frameTime);
+    } else {
+        m_frameTimes[m_nextSample] = frameTime;
+        m_nextSample = (m_nextSample + 1) % windowSize;
+    }
+
+    if (m_isSessionLogging && m_sessionFrameTimes.size() < maxSessionFrames) {
+        m_sessionFrameTimes.push_back(frameTime);
+    }
+
     ++m_frameCount;
 
     m_accumulatedTime += dt;
@@ -11,4 +36,56 @@ void FpsCounter::update(const double dt) noexcept {
     m_fps = m_frameCount / m_accumulatedTime;
     m_frameCount = 0;
     m_accumulatedTime = 0.0;
+
+    updateFrameTimeStats();
+}
+
+void FpsCounter::setSessionLogging(const bool isLogging) {
+    if (isLogging) {
+        m_sessionFrameTimes.reserve(maxSessionFrames);
+    }
+    m_isSessionLogging = isLogging;
+}
+
+void FpsCounter::writeCsv(const std::filesystem::path& path) const {
+    std::ofstream file{ path };
+    if (!file) {
+        throw std::runtime_error{ std::format("Failed to open frame-time file {}", path.string()) };
+    }
+
+    file << "frame,time_ms\n";
+    for (std::size_t i{}; i < m_sessionFrameTimes.size(); ++i) {
+        file << std::format("{},{:.3f}\n", i, m_sessionFrameTimes[i]);
+    }
+
+    if (!file) {
+        throw std::runtime_error{ std::format("Failed to write frame-time file {}", path.string()) };
+    }
+}
+
+void FpsCounter::updateFrameTimeStats() {
+    if (m_frameTimes.empty()) {
+        return;
+    }
+
+    m_sortedFrameTimes.assign(m_frameTimes.begin(), m_frameTimes.end());
+    std::ranges::sort(m_sortedFrameTimes);
+
+    const std::size_t count{ m_sortedFrameTimes.size() };
+    const auto percentile{ [this, count](const double fraction) {
+        const auto index{ static_cast<std::size_t>(std::ceil(fraction * count)) };
+        return static_cast<double>(m_sortedFrameTimes[std::clamp<std::size_t>(index, 1, count) - 1]);
+    } };
+
+    // The slowest 1% of frames, but at least one.
+    const std::size_t slowestCount{ std::max<std::size_t>(count / 100, 1) };
+    const double slowestTime{ std::accumulate(m_sortedFrameTimes.end() - slowestCount, m_sortedFrameTimes.end(), 0.0) };
+
+    m_frameTimeStats = {
+        .p50{ percentile(0.50) },
+        .p95{ percentile(0.95) },
+        .p99{ percentile(0.99) },
+        .max{ m_sortedFrameTimes.back() },
+        .onePercentLowFps{ slowestTime > 0.0 ? 1000.0 * slowestCount / slowestTime : 0.0 },
+    };
 }
@@ -4,15 +4,43 @@
 #define FPS_COUNTER_H
 
 #include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
 
 /**
- * @brief Utility class for calculating frames per second.
+ * @brief Utility class for calculating frames per second and frame-time statistics.
  *
- * Accumulates frame time and frame count to compute
- * average FPS over time.
+ * Accumulates frame time and frame count to compute average FPS over
+ * one-second windows. Additionally keeps the latest frame times in a
+ * rolling window, whose percentiles are refreshed along with the FPS,
+ * and, if enabled, logs every frame time of the session for a CSV export.
  */
 class FpsCounter {
 public:
+    /**
+     * @brief Frame-time distribution of the rolling window, in milliseconds.
+     */
+    struct FrameTimeStats {
+        double p50{};
+        double p95{};
+        double p99{};
+        double max{};
+        double onePercentLowFps{}; ///< Average FPS of the slowest 1% of frames
+    };
+
+    /**
+     * @brief Number of frames in the rolling window.
+     */
+    static constexpr std::size_t windowSize{ 1000 };
+
+    /**
+     * @brief Number of frames logged for the export, later frames are not logged.
+     */
+    static constexpr std::size_t maxSessionFrames{ 1u << 20 };
+
+    FpsCounter();
+
     /**
      * @brief Updates the FPS calculation.
      *
@@ -20,7 +48,15 @@ public:
      *
      * @param dt Delta time in seconds since the last update.
      */
-    void update(const double dt) noexcept;
+    void update(const double dt);
+
+    /**
+     * @brief Starts or stops logging every frame time of the session for writeCsv().
+     *
+     * Starting reserves room for maxSessionFrames frames up front,
+     * so logging never allocates per frame.
+     */
+    void setSessionLogging(const bool isLogging);
 
     /**
      * @brief Returns the current calculated FPS.
@@ -30,10 +66,60 @@ public:
         return m_fps;
     }
 
+    /**
+     * @brief Returns the statistics of the rolling window as of the last FPS refresh.
+     */
+    [[nodiscard]] const FrameTimeStats& getFrameTimeStats() const noexcept {
+        return m_frameTimeStats;
+    }
+
+    /**
+     * @brief Returns the rolling window of frame times in milliseconds.
+     *
+     * The samples form a ring, the oldest one is at getOldestSample()
+     * once the window is full.
+     */
+    [[nodiscard]] std::span<const float> getFrameTimes() const noexcept {
+        return m_frameTimes;
+    }
+
+    [[nodiscard]] std::size_t getOldestSample() const noexcept {
+        return m_nextSample;
+    }
+
+    /**
+     * @brief Returns the time of the latest frame in milliseconds.
+     */
+    [[nodiscard]] float getLatestFrameTime() const noexcept {
+        if (m_frameTimes.empty()) {
+            return 0.f;
+        }
+        return m_frameTimes[(m_nextSample + m_frameTimes.size() - 1) % m_frameTimes.size()];
+    }
+
+    /**
+     * @brief Writes every frame time logged since session logging was started as CSV.
+     *
+     * @param path Output file path.
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void writeCsv(const std::filesystem::path& path) const;
+
 private:
+    void updateFrameTimeStats();
+
     std::size_t m_frameCount{};
     double m_accumulatedTime{};
     double m_fps{};
+
+    std::vector<float> m_frameTimes{};
+    std::size_t m_nextSample{};
+    std::vector<float> m_sortedFrameTimes{};
+    FrameTimeStats m_frameTimeStats{};
+
+    bool m_isSessionLogging{};
+    std::vector<float> m_sessionFrameTimes{};
 };
 
 #endif // FPS_COUNTER_H
@@ -0,0 +1,156 @@
+#include "hitch-detector.h"
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+    struct ChargedZone {
+        std::string name{};
+        std::int64_t selfTime{};
+    };
+
+    /**
+     * @brief Adds the self time of every zone of a thread within a time range to the charged zones.
+     *
+     * Zones are clipped to the range first, clipping keeps them nested.
+     */
+    void chargeZones(
+        const Profiler::ThreadZones& thread,
+        const std::int64_t from,
+        const std::int64_t to,
+        std::vector<ChargedZone>& charged
+    ) {
+        std::vector<Profiler::Zone> zones{ thread.zones };
+        for (Profiler::Zone& zone : zones) {
+            zone.start = std::max(zone.start, from);
+            zone.end = std::min(zone.end, to);
+        }
+
+        // Parents start before their children, or at the same time and end later.
+        std::ranges::sort(zones, [](const Profiler::Zone& lhs, const Profiler::Zone& rhs) {
+            return lhs.start != rhs.start ? lhs.start < rhs.start : lhs.end > rhs.end;
+        });
+
+        std::vector<std::int64_t> selfTimes(zones.size());
+        std::vector<std::size_t> parents{};
+
+        for (std::size_t i{}; i < zones.size(); ++i) {
+            while (!parents.empty() && zones[parents.back()].end <= zones[i].start) {
+                parents.pop_back();
+            }
+
+            const std::int64_t duration{ zones[i].end - zones[i].start };
+            selfTimes[i] += duration;
+            if (!parents.empty()) {
+                selfTimes[parents.back()] -= duration;
+            }
+
+            parents.push_back(i);
+        }
+
+        for (std::size_t i{}; i < zones.size(); ++i) {
+            std::string name{ std::format("{}/{}", thread.threadName, zones[i].name ? zones[i].name : "?") };
+
+            const auto it{ std::ranges::find(charged, name, &ChargedZone::name) };
+            if (it != charged.end()) {
+                it->selfTime += selfTimes[i];
+            } else {
+                charged.push_back({ .name{ std::move(name) }, .selfTime{ selfTimes[i] } });
+            }
+        }
+    }
+}
+
+HitchDetector::HitchDetector(std::filesystem::path reportPath, const double budgetMs)
+    : m_reportPath{ std::move(reportPath) }
+    , m_budget{ static_cast<std::int64_t>(budgetMs * 1e6) }
+{}
+
+HitchDetector::~HitchDetector() {
+    if (m_culpritCounts.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<std::string_view, std::size_t>> culprits(m_culpritCounts.begin(), m_culpritCounts.end());
+    std::ranges::stable_sort(culprits, std::ranges::greater{}, &std::pair<std::string_view, std::size_t>::second);
+
+    std::string line{ std::format("summary: {} hitches in {} frames, main culprits:", m_hitchCount, m_frameIndex) };
+    for (const auto& [name, count] : culprits) {
+        line += std::format(" {} x{},", name, count);
+    }
+    line.pop_back();
+
+    try {
+        append(line);
+    } catch (const std::exception& exception) {
+        std::cerr << "Error when writing a hitch report: " << exception.what() << '\n';
+    }
+}
+
+void HitchDetector::markFrame() noexcept {
+    const std::int64_t now{ Profiler::now() };
+    const std::int64_t frameStart{ std::exchange(m_frameStart, now) };
+    if (frameStart < 0) {
+        return;
+    }
+
+    ++m_frameIndex;
+    if (now - frameStart <= m_budget) {
+        return;
+    }
+
+    ++m_hitchCount;
+    try {
+        report(frameStart, now);
+    } catch (const std::exception& exception) {
+        std::cerr << "Error when writing a hitch report: " << exception.what() << '\n';
+    }
+}
+
+void HitchDetector::report(const std::int64_t frameStart, const std::int64_t frameEnd) {
+    std::vector<ChargedZone> charged{};
+    for (const Profiler::ThreadZones& thread : Profiler::collectZones(frameStart, frameEnd)) {
+        chargeZones(thread, frameStart, frameEnd, charged);
+    }
+
+    const std::size_t reportedCount{ std::min(charged.size(), reportedZoneCount) };
+    std::ranges::partial_sort(charged, charged.begin() + reportedCount, std::ranges::greater{}, &ChargedZone::selfTime);
+
+    std::string line{ std::format("frame {}: {:.1f} ms (budget {:.1f} ms)",
+        m_frameIndex,
+        static_cast<double>(frameEnd - frameStart) / 1e6,
+        static_cast<double>(m_budget) / 1e6) };
+
+    if (reportedCount == 0) {
+        line += " | no zones recorded";
+    } else {
+        ++m_culpritCounts[charged.front().name];
+    }
+
+    for (std::size_t i{}; i < reportedCount; ++i) {
+        line += std::format("{} {} {:.1f} ms", i == 0 ? " |" : ",", charged[i].name, static_cast<double>(charged[i].selfTime) / 1e6);
+    }
+
+    append(line);
+}
+
+void HitchDetector::append(const std::string& line) {
+    std::ofstream file{ m_reportPath, std::ios::app };
+    if (!file) {
+        throw std::runtime_error{ std::format("Failed to open hitch report {}", m_reportPath.string()) };
+    }
+
+    file << line << '\n';
+
+    if (!file) {
+        throw std::runtime_error{ std::format("Failed to write hitch report {}", m_reportPath.string()) };
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef HITCH_DETECTOR_H
+#define HITCH_DETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+
+/**
+ * @brief Watchdog attributing frames over a time budget to profiled zones.
+ *
+ * Whenever a frame exceeds the budget, the zones every thread recorded
+ * during the frame are collected from the Profiler, which therefore
+ * has to be enabled. Each zone is charged its self time, its duration
+ * without nested zones, and the zones charged the most are appended
+ * as a single line to the report file. Time outside of any zone shows
+ * up under the outermost zone of its thread, such as "Frame".
+ *
+ * On destruction a summary line counts how often each zone was the
+ * main culprit, so recurring stalls stand out in field logs.
+ */
+class HitchDetector {
+public:
+    /**
+     * @brief Number of zones listed per hitch.
+     */
+    static constexpr std::size_t reportedZoneCount{ 5 };
+
+    /**
+     * @param reportPath File the reports are appended to, created on the first hitch.
+     * @param budgetMs Frame time in milliseconds above which a frame is a hitch.
+     */
+    HitchDetector(std::filesystem::path reportPath, const double budgetMs);
+
+    /**
+     * @brief Appends the summary if there were hitches.
+     */
+    ~HitchDetector();
+
+    HitchDetector(const HitchDetector&) = delete;
+    HitchDetector& operator=(const HitchDetector&) = delete;
+
+    HitchDetector(HitchDetector&&) = delete;
+    HitchDetector& operator=(HitchDetector&&) = delete;
+
+    /**
+     * @brief Ends the previous frame at the current time and starts the next one.
+     *
+     * Should be called once at the beginning of every frame. Failures
+     * to write the report are printed instead of thrown.
+     */
+    void markFrame() noexcept;
+
+    [[nodiscard]] std::size_t getHitchCount() const noexcept { return m_hitchCount; }
+
+private:
+    void report(const std::int64_t frameStart, const std::int64_t frameEnd);
+    void append(const std::string& line);
+
+    std::filesystem::path m_reportPath{};
+    std::int64_t m_budget{}; ///< In nanoseconds
+    std::int64_t m_frameStart{ -1 };
+    std::size_t m_frameIndex{};
+    std::size_t m_hitchCount{};
+
+    /// Number of hitches each zone, prefixed by its thread, was charged the most.
+    std::map<std::string, std::size_t> m_culpritCounts{};
+};
+
+#endif // HITCH_DETECTOR_H
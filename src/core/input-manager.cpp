@@ -9,9 +9,8 @@ InputManager::InputManager(GLFWwindow* const window) noexcept
 {}
 
 InputManager::InputManager(InputManager&& other) noexcept
-    : m_window        { std::exchange(other.m_window, nullptr) }
-    , m_currentStates { std::move(other.m_currentStates) }
-    , m_previousStates{ std::move(other.m_previousStates) }
+    : InputState{ std::move(other) }
+    , m_window  { std::exchange(other.m_window, nullptr) }
 {}
 
 InputManager& InputManager::operator=(InputManager&& other) noexcept {
@@ -19,9 +18,8 @@ InputManager& InputManager::operator=(InputManager&& other) noexcept {
         return *this;
     }
 
-    m_window         = std::exchange(other.m_window, nullptr);
-    m_currentStates  = std::move(other.m_currentStates);
-    m_previousStates = std::move(other.m_previousStates);
+    InputState::operator=(std::move(other));
+    m_window = std::exchange(other.m_window, nullptr);
 
     return *this;
 }
@@ -31,10 +29,11 @@ void InputManager::update() noexcept {
         return;
     }
 
-    m_previousStates = m_currentStates;
+    KeyStates keyStates{};
+    keyStates[Key::A]      = glfwGetKey(m_window, GLFW_KEY_A) == GLFW_PRESS;
+    keyStates[Key::D]      = glfwGetKey(m_window, GLFW_KEY_D) == GLFW_PRESS;
+    keyStates[Key::Space]  = glfwGetKey(m_window, GLFW_KEY_SPACE) == GLFW_PRESS;
+    keyStates[Key::Escape] = glfwGetKey(m_window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
 
-    m_currentStates[Key::A]      = glfwGetKey(m_window, GLFW_KEY_A) == GLFW_PRESS;
-    m_currentStates[Key::D]      = glfwGetKey(m_window, GLFW_KEY_D) == GLFW_PRESS;
-    m_currentStates[Key::Space]  = glfwGetKey(m_window, GLFW_KEY_SPACE) == GLFW_PRESS;
-    m_currentStates[Key::Escape] = glfwGetKey(m_window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
+    setKeyStates(keyStates);
 }
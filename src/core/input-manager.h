@@ -3,27 +3,18 @@
 #ifndef INPUT_MANAGER_H
 #define INPUT_MANAGER_H
 
-#include <array>
-#include <cstddef>
+#include "input-state.h"
 
 struct GLFWwindow;
 
 /**
  * @brief Handles keyboard input state tracking.
  *
- * Tracks current and previous key states
- * to detect presses and holds.
+ * Reads key states from a GLFW window and tracks current and
+ * previous key states to detect presses and holds.
  */
-class InputManager {
+class InputManager : public InputState {
 public:
-    enum Key {
-        A,
-        D,
-        Space,
-        Escape,
-        KEY_COUNT,
-    };
-
     /**
      * @brief Constructs the input manager.
      * @param window GLFW window to read input from.
@@ -43,25 +34,8 @@ public:
      */
     void update() noexcept;
 
-    /**
-     * @brief Checks if a key was down during the latest update.
-     */
-    [[nodiscard]] bool isDown(const Key key) const noexcept { return m_currentStates[key]; }
-
-    /**
-     * @brief Checks if a was down during both previous and latest updates.
-     */
-    [[nodiscard]] bool isHeld(const Key key) const noexcept { return m_currentStates[key] && m_previousStates[key]; }
-
-    /**
-     * @brief Checks if a key was pressed this frame (up in the previous update and down in the latest one).
-     */
-    [[nodiscard]] bool isPressed(const Key key) const noexcept { return m_currentStates[key] && !m_previousStates[key]; }
-
 private:
     GLFWwindow* m_window{};
-    std::array<bool, Key::KEY_COUNT> m_currentStates{};
-    std::array<bool, Key::KEY_COUNT> m_previousStates{};
 };
 
 #endif // INPUT_MANAGER_H
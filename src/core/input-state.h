@@ -0,0 +1,58 @@
+#pragma once
+
+#ifndef INPUT_STATE_H
+#define INPUT_STATE_H
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief Platform independent keyboard state.
+ *
+ * Stores current and previous key states to detect presses and holds.
+ * The states can be fed from a window (see InputManager) or injected
+ * directly, which allows driving the game without a display.
+ */
+class InputState {
+public:
+    enum Key {
+        A,
+        D,
+        Space,
+        Escape,
+        KEY_COUNT,
+    };
+
+    using KeyStates = std::array<bool, Key::KEY_COUNT>;
+
+    /**
+     * @brief Pushes a new set of key states, the current ones become the previous ones.
+     *
+     * Should be called once per frame.
+     */
+    void setKeyStates(const KeyStates& keyStates) noexcept {
+        m_previousStates = m_currentStates;
+        m_currentStates = keyStates;
+    }
+
+    /**
+     * @brief Checks if a key was down during the latest update.
+     */
+    [[nodiscard]] bool isDown(const Key key) const noexcept { return m_currentStates[key]; }
+
+    /**
+     * @brief Checks if a was down during both previous and latest updates.
+     */
+    [[nodiscard]] bool isHeld(const Key key) const noexcept { return m_currentStates[key] && m_previousStates[key]; }
+
+    /**
+     * @brief Checks if a key was pressed this frame (up in the previous update and down in the latest one).
+     */
+    [[nodiscard]] bool isPressed(const Key key) const noexcept { return m_currentStates[key] && !m_previousStates[key]; }
+
+protected:
+    KeyStates m_currentStates{};
+    KeyStates m_previousStates{};
+};
+
+#endif // INPUT_STATE_H
@@ -0,0 +1,266 @@
+#include "job-system.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <format>
+#include <utility>
+
+struct JobHandle::Job {
+    JobSystem::Function function{};
+
+    /// The job itself plus its unfinished children.
+    std::atomic<std::uint32_t> unfinishedCount{ 1 };
+    std::shared_ptr<Job> parent{};
+
+    std::mutex continuationMutex{};
+    std::vector<std::shared_ptr<Job>> continuations{};
+    bool isFinished{};
+};
+
+namespace {
+    /// Worker index of the current thread, only meaningful when t_owner matches.
+    thread_local const JobSystem* t_owner{};
+    thread_local std::size_t t_workerIndex{};
+}
+
+bool JobHandle::isDone() const noexcept {
+    return !m_job || m_job->unfinishedCount.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::JobSystem(const std::size_t threadCount)
+    : m_workerCount{ std::max<std::size_t>(threadCount, 1) } {
+    m_queues.reserve(m_workerCount + 1);
+    for (std::size_t i{}; i <= m_workerCount; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+
+    m_threads.reserve(m_workerCount);
+
+    try {
+        for (std::size_t i{}; i < m_workerCount; ++i) {
+            m_threads.emplace_back([this, i] { runWorker(i); });
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+JobSystem::~JobSystem() {
+    stop();
+}
+
+void JobSystem::stop() noexcept {
+    {
+        const std::lock_guard lock{ m_sleepMutex };
+        m_isStopping = true;
+    }
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+}
+
+JobHandle JobSystem::schedule(Function function) {
+    auto job{ std::make_shared<JobHandle::Job>() };
+    job->function = std::move(function);
+
+    push(job);
+    return JobHandle{ std::move(job) };
+}
+
+JobHandle JobSystem::schedule(Function function, const JobHandle& parent) {
+    auto job{ std::make_shared<JobHandle::Job>() };
+    job->function = std::move(function);
+
+    if (parent.m_job) {
+        parent.m_job->unfinishedCount.fetch_add(1, std::memory_order_relaxed);
+        job->parent = parent.m_job;
+    }
+
+    push(job);
+    return JobHandle{ std::move(job) };
+}
+
+JobHandle JobSystem::then(const JobHandle& antecedent, Function function) {
+    auto job{ std::make_shared<JobHandle::Job>() };
+    job->function = std::move(function);
+
+    if (antecedent.m_job) {
+        const std::lock_guard lock{ antecedent.m_job->continuationMutex };
+        if (!antecedent.m_job->isFinished) {
+            antecedent.m_job->continuations.push_back(job);
+            return JobHandle{ std::move(job) };
+        }
+    }
+
+    push(job);
+    return JobHandle{ std::move(job) };
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    helpUntil([&job] { return job.isDone(); });
+}
+
+void JobSystem::helpUntil(const std::function<bool()>& isDone) {
+    while (!isDone()) {
+        if (const JobPointer job{ pop() }) {
+            run(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(
+    const std::size_t count,
+    const std::size_t grainSize,
+    const std::function<void(std::size_t, std::size_t)>& function
+) {
+    const std::size_t chunkSize{ std::max<std::size_t>(grainSize, 1) };
+    if (count <= chunkSize) {
+        if (count > 0) {
+            function(0, count);
+        }
+        return;
+    }
+
+    // The group only finishes once the calling thread is done with the first chunk
+    // and every scheduled chunk has run.
+    const JobHandle group{ std::make_shared<JobHandle::Job>() };
+
+    for (std::size_t begin{ chunkSize }; begin < count; begin += chunkSize) {
+        const std::size_t end{ std::min(begin + chunkSize, count) };
+        schedule([&function, begin, end] { function(begin, end); }, group);
+    }
+
+    function(0, chunkSize);
+    finish(group.m_job);
+    wait(group);
+}
+
+std::size_t JobSystem::getDefaultThreadCount() noexcept {
+    const unsigned int hardwareThreads{ std::thread::hardware_concurrency() };
+    return std::max(hardwareThreads, 2u) - 1;
+}
+
+void JobSystem::push(JobPointer job) {
+    const bool isWorker{ t_owner == this };
+    Queue& queue{ *m_queues[isWorker ? t_workerIndex : m_workerCount] };
+
+    // Counted before it is visible, so the count never drops below the queued jobs.
+    // Sleepers register before rechecking the count, so either they see this job
+    // or this thread sees them and wakes one up.
+    m_queuedCount.fetch_add(1);
+    {
+        const std::lock_guard lock{ queue.mutex };
+        queue.jobs.push_back(std::move(job));
+    }
+
+    if (m_sleepingCount.load() > 0) {
+        { const std::lock_guard lock{ m_sleepMutex }; }
+        m_wake.notify_one();
+    }
+}
+
+JobSystem::JobPointer JobSystem::pop() {
+    const auto take{ [this](Queue& queue, const bool isOwner) -> JobPointer {
+        const std::lock_guard lock{ queue.mutex };
+        if (queue.jobs.empty()) {
+            return nullptr;
+        }
+
+        JobPointer job{};
+        if (isOwner) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        } else {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+
+        m_queuedCount.fetch_sub(1);
+        return job;
+    } };
+
+    const bool isWorker{ t_owner == this };
+    const std::size_t self{ isWorker ? t_workerIndex : m_workerCount };
+
+    if (isWorker) {
+        if (JobPointer job{ take(*m_queues[self], true) }) {
+            return job;
+        }
+    }
+
+    if (JobPointer job{ take(*m_queues[m_workerCount], false) }) {
+        return job;
+    }
+
+    for (std::size_t i{ 1 }; i <= m_workerCount; ++i) {
+        const std::size_t victim{ (self + i) % (m_workerCount + 1) };
+        if (victim == m_workerCount) {
+            continue;
+        }
+
+        if (JobPointer job{ take(*m_queues[victim], false) }) {
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+void JobSystem::run(const JobPointer& job) noexcept {
+    if (job->function) {
+        job->function();
+        // Captures may hold resources, release them as soon as the job is done.
+        job->function = nullptr;
+    }
+
+    finish(job);
+}
+
+void JobSystem::finish(const JobPointer& job) {
+    if (job->unfinishedCount.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    std::vector<JobPointer> continuations{};
+    {
+        const std::lock_guard lock{ job->continuationMutex };
+        job->isFinished = true;
+        continuations.swap(job->continuations);
+    }
+
+    for (auto& continuation : continuations) {
+        push(std::move(continuation));
+    }
+
+    if (job->parent) {
+        finish(std::exchange(job->parent, nullptr));
+    }
+}
+
+void JobSystem::runWorker(const std::size_t index) {
+    t_owner = this;
+    t_workerIndex = index;
+    Profiler::setThreadName(std::format("Job worker {}", index));
+
+    while (true) {
+        if (const JobPointer job{ pop() }) {
+            run(job);
+            continue;
+        }
+
+        std::unique_lock lock{ m_sleepMutex };
+        m_sleepingCount.fetch_add(1);
+        m_wake.wait(lock, [this] { return m_isStopping || m_queuedCount.load() > 0; });
+        m_sleepingCount.fetch_sub(1);
+
+        if (m_isStopping && m_queuedCount.load() == 0) {
+            return;
+        }
+    }
+}
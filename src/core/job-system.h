@@ -0,0 +1,167 @@
+#pragma once
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @brief Reference to a scheduled job, used to wait for it or chain continuations.
+ *
+ * A job is done once its function and all of its child jobs have finished.
+ */
+class JobHandle {
+public:
+    /**
+     * @brief Creates a handle not referring to any job, it counts as done.
+     */
+    JobHandle() = default;
+
+    [[nodiscard]] bool isValid() const noexcept {
+        return m_job != nullptr;
+    }
+
+    [[nodiscard]] bool isDone() const noexcept;
+
+private:
+    friend class JobSystem;
+
+    struct Job;
+
+    explicit JobHandle(std::shared_ptr<Job> job) noexcept
+        : m_job{ std::move(job) }
+    {}
+
+    std::shared_ptr<Job> m_job{};
+};
+
+/**
+ * @brief Work-stealing thread pool running small jobs.
+ *
+ * Every worker owns a deque. Jobs scheduled from a worker go to the back
+ * of its own deque and are taken from there last in, first out, so nested
+ * work stays cache-warm. Idle workers steal from the front of other deques.
+ * Jobs scheduled from other threads go through a shared injection queue.
+ *
+ * Waiting never blocks a thread that could make progress: wait() and
+ * parallelFor() run queued jobs until the awaited work is done,
+ * which also makes nested waits inside jobs safe.
+ *
+ * Jobs must not throw, an escaping exception terminates the program.
+ * Long blocking jobs, like file loading, are fine but occupy a worker.
+ */
+class JobSystem {
+public:
+    using Function = std::function<void()>;
+
+    /**
+     * @brief Starts the workers.
+     *
+     * @param threadCount Number of worker threads, defaults to one less than the
+     *        hardware concurrency, but at least one so jobs progress without waiters.
+     */
+    explicit JobSystem(const std::size_t threadCount = getDefaultThreadCount());
+
+    /**
+     * @brief Runs the queued jobs to completion and joins the workers.
+     */
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    /**
+     * @brief Schedules an independent job.
+     */
+    JobHandle schedule(Function function);
+
+    /**
+     * @brief Schedules a child job, the parent is not done before the child is.
+     *
+     * @param parent Job that has not finished yet, typically the one scheduling the child.
+     */
+    JobHandle schedule(Function function, const JobHandle& parent);
+
+    /**
+     * @brief Schedules a job to run once another one is done.
+     *
+     * @param antecedent Job to wait for, an invalid handle schedules the continuation right away.
+     */
+    JobHandle then(const JobHandle& antecedent, Function function);
+
+    /**
+     * @brief Runs queued jobs until the given job is done.
+     */
+    void wait(const JobHandle& job);
+
+    /**
+     * @brief Runs queued jobs until the predicate holds.
+     *
+     * The predicate is polled between jobs, from the calling thread only.
+     */
+    void helpUntil(const std::function<bool()>& isDone);
+
+    /**
+     * @brief Splits [0, count) into chunks processed in parallel and waits for all of them.
+     *
+     * The calling thread processes the first chunk and helps with the rest.
+     *
+     * @param count Number of elements.
+     * @param grainSize Maximum number of elements per chunk.
+     * @param function Called with the begin and end index of every chunk.
+     */
+    void parallelFor(
+        const std::size_t count,
+        const std::size_t grainSize,
+        const std::function<void(std::size_t, std::size_t)>& function
+    );
+
+    [[nodiscard]] std::size_t getThreadCount() const noexcept {
+        return m_workerCount;
+    }
+
+    [[nodiscard]] static std::size_t getDefaultThreadCount() noexcept;
+
+private:
+    using JobPointer = std::shared_ptr<JobHandle::Job>;
+
+    struct Queue {
+        std::mutex mutex{};
+        std::deque<JobPointer> jobs{};
+    };
+
+    void stop() noexcept;
+    void push(JobPointer job);
+    [[nodiscard]] JobPointer pop();
+    void run(const JobPointer& job) noexcept;
+    void finish(const JobPointer& job);
+    void runWorker(const std::size_t index);
+
+    /// One queue per worker, followed by the injection queue of other threads.
+    std::vector<std::unique_ptr<Queue>> m_queues{};
+    std::vector<std::thread> m_threads{};
+    /// Fixed before the workers start, unlike the size of m_threads.
+    std::size_t m_workerCount{};
+
+    std::atomic<std::size_t> m_queuedCount{};
+    std::atomic<std::size_t> m_sleepingCount{};
+    std::atomic<bool> m_isStopping{};
+    std::mutex m_sleepMutex{};
+    std::condition_variable m_wake{};
+};
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,116 @@
+#include "mapped-file.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    const auto fail{ [&path](const char* const reason) {
+        return std::runtime_error{ std::format("Failed to map {}: {}", path.generic_string(), reason) };
+    } };
+
+#ifdef _WIN32
+    const HANDLE file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL) };
+    if (file == INVALID_HANDLE_VALUE) {
+        throw fail("cannot open the file");
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw fail("cannot query the file size");
+    }
+
+    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+    if (!m_size) {
+        CloseHandle(file);
+        return;
+    }
+
+    // The view keeps the mapping alive, both handles can be closed right away.
+    const HANDLE mapping{ CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL) };
+    CloseHandle(file);
+    if (!mapping) {
+        m_size = 0;
+        throw fail("CreateFileMapping failed");
+    }
+
+    m_data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if (!m_data) {
+        m_size = 0;
+        throw fail("MapViewOfFile failed");
+    }
+#else
+    const int file{ open(path.c_str(), O_RDONLY) };
+    if (file < 0) {
+        throw fail("cannot open the file");
+    }
+
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0) {
+        close(file);
+        throw fail("cannot query the file size");
+    }
+
+    m_size = static_cast<std::size_t>(fileStat.st_size);
+    if (!m_size) {
+        close(file);
+        return;
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    void* const data{ mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, file, 0) };
+    close(file);
+    if (data == MAP_FAILED) {
+        m_size = 0;
+        throw fail("mmap failed");
+    }
+
+    m_data = static_cast<const std::byte*>(data);
+#endif // _WIN32
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data{ std::exchange(other.m_data, nullptr) }
+    , m_size{ std::exchange(other.m_size, 0) }
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    unmap();
+
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+
+    return *this;
+}
+
+void MappedFile::unmap() noexcept {
+    if (!m_data) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<std::byte*>(m_data), m_size);
+#endif // _WIN32
+
+    m_data = nullptr;
+    m_size = 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The file contents are accessible for the lifetime of the object
+ * without being copied into process memory up front.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Maps a file into memory.
+     *
+     * @param path Path to the file.
+     *
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile() {
+        unmap();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Returns the mapped file contents.
+     */
+    [[nodiscard]] std::span<const std::byte> getData() const noexcept {
+        return { m_data, m_size };
+    }
+
+private:
+    void unmap() noexcept;
+
+    const std::byte* m_data{};
+    std::size_t m_size{};
+};
+
+#endif // MAPPED_FILE_H
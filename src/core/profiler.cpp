@@ -0,0 +1,234 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Ring buffer slot, atomic so the export may read while the owner overwrites it.
+     */
+    struct ZoneSlot {
+        std::atomic<const char*> name{};
+        std::atomic<std::int64_t> start{};
+        std::atomic<std::int64_t> end{};
+    };
+
+    /**
+     * @brief Per-thread recording state, the ring is allocated by the first recorded zone.
+     *
+     * Threads which only get named, or never record while the profiler is enabled,
+     * do not pay for the ring.
+     */
+    struct ThreadBuffer {
+        std::unique_ptr<ZoneSlot[]> zoneStorage{};
+        std::atomic<ZoneSlot*> zones{};
+        std::atomic<std::uint64_t> recordedCount{};
+        std::uint32_t id{};
+        std::string name{};
+    };
+
+    struct ProfilerState {
+        std::atomic<bool> isEnabled{};
+        std::int64_t startTime{ Profiler::now() };
+
+        std::mutex threadsMutex{};
+        std::vector<std::unique_ptr<ThreadBuffer>> threads{};
+    };
+
+    static_assert((Profiler::zonesPerThread & (Profiler::zonesPerThread - 1)) == 0);
+
+    ProfilerState& getState() {
+        static ProfilerState state{};
+        return state;
+    }
+
+    thread_local ThreadBuffer* t_buffer{};
+
+    /**
+     * @brief Returns the buffer of the calling thread, registering it on first use.
+     *
+     * Buffers outlive their threads, so zones of finished threads are still exported.
+     */
+    ThreadBuffer& getThreadBuffer() {
+        if (!t_buffer) {
+            ProfilerState& state{ getState() };
+            const std::lock_guard lock{ state.threadsMutex };
+
+            auto buffer{ std::make_unique<ThreadBuffer>() };
+            buffer->id = static_cast<std::uint32_t>(state.threads.size() + 1);
+            buffer->name = std::format("Thread {}", buffer->id);
+            t_buffer = state.threads.emplace_back(std::move(buffer)).get();
+        }
+
+        return *t_buffer;
+    }
+
+    /**
+     * @brief Copies the zones of a thread still in its ring, oldest first.
+     */
+    void copyZones(const ThreadBuffer& buffer, std::vector<Profiler::Zone>& zones) {
+        zones.clear();
+
+        const ZoneSlot* const slots{ buffer.zones.load(std::memory_order_acquire) };
+        if (!slots) {
+            return;
+        }
+
+        const std::uint64_t end{ buffer.recordedCount.load(std::memory_order_acquire) };
+        const std::uint64_t begin{ end > Profiler::zonesPerThread ? end - Profiler::zonesPerThread : 0 };
+
+        for (std::uint64_t i{ begin }; i < end; ++i) {
+            const ZoneSlot& slot{ slots[i & (Profiler::zonesPerThread - 1)] };
+            zones.push_back({
+                .name{ slot.name.load(std::memory_order_relaxed) },
+                .start{ slot.start.load(std::memory_order_relaxed) },
+                .end{ slot.end.load(std::memory_order_relaxed) },
+            });
+        }
+
+        // Slots the owner wrapped around to while they were copied hold newer zones, drop them.
+        const std::uint64_t recordedAfter{ buffer.recordedCount.load(std::memory_order_acquire) };
+        const std::uint64_t firstIntact{ recordedAfter > Profiler::zonesPerThread ? recordedAfter - Profiler::zonesPerThread : 0 };
+        const auto overwritten{ static_cast<std::ptrdiff_t>(std::min(end, std::max(firstIntact, begin)) - begin) };
+
+        zones.erase(zones.begin(), zones.begin() + overwritten);
+    }
+
+    void writeEscaped(std::ofstream& file, const std::string_view text) {
+        for (const char character : text) {
+            if (character == '"' || character == '\\') {
+                file << '\\';
+            }
+            file << character;
+        }
+    }
+}
+
+void Profiler::setEnabled(const bool isEnabled) noexcept {
+    getState().isEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() noexcept {
+    return getState().isEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(std::string name) {
+    ThreadBuffer& buffer{ getThreadBuffer() };
+
+    const std::lock_guard lock{ getState().threadsMutex };
+    buffer.name = std::move(name);
+}
+
+void Profiler::record(const char* const name, const std::int64_t start, const std::int64_t end) noexcept {
+    ThreadBuffer* buffer{ t_buffer };
+    if (!buffer) {
+        try {
+            buffer = &getThreadBuffer();
+        } catch (...) {
+            return;
+        }
+    }
+
+    ZoneSlot* slots{ buffer->zones.load(std::memory_order_relaxed) };
+    if (!slots) {
+        try {
+            buffer->zoneStorage = std::make_unique<ZoneSlot[]>(zonesPerThread);
+        } catch (...) {
+            return;
+        }
+        slots = buffer->zoneStorage.get();
+        buffer->zones.store(slots, std::memory_order_release);
+    }
+
+    const std::uint64_t index{ buffer->recordedCount.load(std::memory_order_relaxed) };
+    ZoneSlot& slot{ slots[index & (zonesPerThread - 1)] };
+
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+
+    buffer->recordedCount.store(index + 1, std::memory_order_release);
+}
+
+std::int64_t Profiler::now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+void Profiler::writeChromeTrace(const std::filesystem::path& path) {
+    std::ofstream file{ path };
+    if (!file) {
+        throw std::runtime_error{ std::format("Failed to open trace file {}", path.string()) };
+    }
+
+    ProfilerState& state{ getState() };
+    const std::lock_guard lock{ state.threadsMutex };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool isFirst{ true };
+
+    const auto separate{ [&file, &isFirst] {
+        if (!isFirst) {
+            file << ",\n";
+        }
+        isFirst = false;
+    } };
+
+    std::vector<Zone> zones{};
+
+    for (const auto& buffer : state.threads) {
+        separate();
+        file << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->id << R"(,"args":{"name":")";
+        writeEscaped(file, buffer->name);
+        file << "\"}}";
+
+        copyZones(*buffer, zones);
+
+        for (const Zone& zone : zones) {
+            separate();
+            file << "{\"name\":\"";
+            writeEscaped(file, zone.name ? zone.name : "");
+            file << R"(","ph":"X","pid":1,"tid":)" << buffer->id
+                << std::format(R"(,"ts":{:.3f},"dur":{:.3f})",
+                    static_cast<double>(zone.start - state.startTime) / 1e3,
+                    static_cast<double>(zone.end - zone.start) / 1e3)
+                << '}';
+        }
+    }
+
+    file << "\n]}\n";
+
+    if (!file) {
+        throw std::runtime_error{ std::format("Failed to write trace file {}", path.string()) };
+    }
+}
+
+std::vector<Profiler::ThreadZones> Profiler::collectZones(const std::int64_t from, const std::int64_t to) {
+    ProfilerState& state{ getState() };
+    const std::lock_guard lock{ state.threadsMutex };
+
+    std::vector<ThreadZones> threads{};
+    std::vector<Zone> zones{};
+
+    for (const auto& buffer : state.threads) {
+        copyZones(*buffer, zones);
+        std::erase_if(zones, [from, to](const Zone& zone) {
+            return zone.end < from || zone.start > to;
+        });
+
+        if (!zones.empty()) {
+            threads.push_back({ .threadName{ buffer->name }, .zones{ zones } });
+        }
+    }
+
+    return threads;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "allocation-tracker.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Process-wide recorder of timed CPU zones.
+ *
+ * Every thread records into its own fixed-size ring buffer without locks,
+ * the oldest zones are overwritten once it is full. The ring is allocated
+ * by the first zone a thread records, naming a thread does not allocate it. Recording is off until
+ * setEnabled() turns it on, a disabled zone costs a single relaxed load.
+ * Building without ENABLE_PROFILER compiles PROFILE_ZONE out entirely.
+ *
+ * Zone names are stored as pointers, so they have to outlive the
+ * export, string literals being the usual choice.
+ */
+class Profiler {
+public:
+    /**
+     * @brief Zones kept per thread before the oldest ones are overwritten.
+     */
+    static constexpr std::size_t zonesPerThread{ 1u << 16 };
+
+    /**
+     * @brief Recorded zone, times in nanoseconds of now().
+     */
+    struct Zone {
+        const char* name{};
+        std::int64_t start{};
+        std::int64_t end{};
+    };
+
+    /**
+     * @brief Recorded zones of one thread.
+     */
+    struct ThreadZones {
+        std::string threadName{};
+        std::vector<Zone> zones{};
+    };
+
+    Profiler() = delete;
+
+    static void setEnabled(const bool isEnabled) noexcept;
+    [[nodiscard]] static bool isEnabled() noexcept;
+
+    /**
+     * @brief Names the calling thread in exported traces.
+     *
+     * Only stores the name, the zone ring is allocated on the first recorded zone.
+     */
+    static void setThreadName(std::string name);
+
+    /**
+     * @brief Records a finished zone on the calling thread.
+     *
+     * @param name Zone name, has to outlive the export.
+     * @param start Start time, see now().
+     * @param end End time, see now().
+     */
+    static void record(const char* const name, const std::int64_t start, const std::int64_t end) noexcept;
+
+    /**
+     * @brief Returns the current time in nanoseconds of a monotonic clock.
+     */
+    [[nodiscard]] static std::int64_t now() noexcept;
+
+    /**
+     * @brief Writes the recorded zones of every thread as Chrome trace-event JSON.
+     *
+     * The file opens in chrome://tracing or Perfetto. Threads may keep
+     * recording meanwhile, zones overwritten during the export are skipped.
+     *
+     * @param path Output file path.
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    static void writeChromeTrace(const std::filesystem::path& path);
+
+    /**
+     * @brief Returns the still recorded zones of every thread overlapping a time range.
+     *
+     * Zones are in the order they finished, threads without such zones are left out.
+     *
+     * @param from Start of the range, see now().
+     * @param to End of the range, see now().
+     */
+    [[nodiscard]] static std::vector<ThreadZones> collectZones(const std::int64_t from, const std::int64_t to);
+};
+
+/**
+ * @brief Records the lifetime of a scope as a zone, if the profiler is enabled.
+ *
+ * With ENABLE_ALLOCATION_TRACKING the zone is also charged the allocations
+ * of its scope outside of nested zones in the AllocationTracker, whether
+ * the profiler is enabled or not.
+ *
+ * Use through PROFILE_ZONE, which compiles out without ENABLE_PROFILER.
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* const name) noexcept
+        : m_name{ name }
+        , m_start{ Profiler::isEnabled() ? Profiler::now() : -1 }
+    {
+#ifdef ENABLE_ALLOCATION_TRACKING
+        m_allocationZone = AllocationTracker::enterZone(name);
+#endif // ENABLE_ALLOCATION_TRACKING
+    }
+
+    ~ProfileZone() {
+        if (m_start >= 0) {
+            Profiler::record(m_name, m_start, Profiler::now());
+        }
+
+#ifdef ENABLE_ALLOCATION_TRACKING
+        AllocationTracker::leaveZone(m_name, m_allocationZone);
+#endif // ENABLE_ALLOCATION_TRACKING
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    ProfileZone(ProfileZone&&) = delete;
+    ProfileZone& operator=(ProfileZone&&) = delete;
+
+private:
+    const char* m_name{};
+    std::int64_t m_start{};
+#ifdef ENABLE_ALLOCATION_TRACKING
+    AllocationTracker::ZoneState m_allocationZone{};
+#endif // ENABLE_ALLOCATION_TRACKING
+};
+
+#define PROFILE_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define PROFILE_CONCAT(lhs, rhs) PROFILE_CONCAT_IMPL(lhs, rhs)
+
+#ifdef ENABLE_PROFILER
+    /**
+     * @brief Profiles the rest of the enclosing scope under the given name.
+     */
+    #define PROFILE_ZONE(name) const ProfileZone PROFILE_CONCAT(profileZone, __LINE__){ name }
+#else
+    #define PROFILE_ZONE(name) static_cast<void>(0)
+#endif // ENABLE_PROFILER
+
+#endif // PROFILER_H
@@ -0,0 +1,45 @@
+#include "random.h"
+
+/**
+ * @brief SplitMix64 step, used to expand seeds into generator states.
+ */
+[[nodiscard]] static std::uint64_t splitMix64(std::uint64_t& state) noexcept {
+    std::uint64_t result{ state += 0x9E3779B97F4A7C15 };
+    result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9;
+    result = (result ^ (result >> 27)) * 0x94D049BB133111EB;
+    return result ^ (result >> 31);
+}
+
+Xoshiro256::Xoshiro256(const std::uint64_t seed) noexcept {
+    std::uint64_t splitMixState{ seed };
+    for (auto& word : m_state) {
+        word = splitMix64(splitMixState);
+    }
+}
+
+void RandomStreams::reseed(const std::uint64_t seed) noexcept {
+    m_seed = seed;
+
+    for (auto& [name, stream] : m_streams) {
+        stream = Xoshiro256{ getStreamSeed(m_seed, name) };
+    }
+}
+
+Xoshiro256& RandomStreams::getStream(const std::string_view name) {
+    if (const auto it{ m_streams.find(name) }; it != m_streams.end()) {
+        return it->second;
+    }
+
+    return m_streams.emplace(std::string{ name }, Xoshiro256{ getStreamSeed(m_seed, name) }).first->second;
+}
+
+std::uint64_t RandomStreams::getStreamSeed(const std::uint64_t seed, const std::string_view name) noexcept {
+    // FNV-1a, std::hash is not guaranteed to be stable across implementations.
+    std::uint64_t hash{ 0xCBF29CE484222325 };
+    for (const char character : name) {
+        hash = (hash ^ static_cast<unsigned char>(character)) * 0x100000001B3;
+    }
+
+    std::uint64_t state{ seed ^ hash };
+    return splitMix64(state);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief xoshiro256** pseudo random number generator.
+ *
+ * Small, fast and fully specified, so a given seed produces the same
+ * sequence on every platform and standard library, unlike the
+ * distributions of <random>. Satisfies UniformRandomBitGenerator.
+ */
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    /**
+     * @brief Seeds the generator, expanding the seed with SplitMix64.
+     */
+    explicit Xoshiro256(const std::uint64_t seed = 0) noexcept;
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() noexcept {
+        const std::uint64_t result{ rotateLeft(m_state[1] * 5, 7) * 9 };
+        const std::uint64_t shifted{ m_state[1] << 17 };
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= shifted;
+        m_state[3] = rotateLeft(m_state[3], 45);
+
+        return result;
+    }
+
+    /**
+     * @brief Returns a float in the range [0, 1) built from the top 24 bits.
+     */
+    [[nodiscard]] float nextFloat() noexcept {
+        return static_cast<float>((*this)() >> 40) * 0x1.0p-24f;
+    }
+
+    /**
+     * @brief Returns a float in the range [min, max).
+     */
+    [[nodiscard]] float uniform(const float min, const float max) noexcept {
+        return min + (max - min) * nextFloat();
+    }
+
+private:
+    [[nodiscard]] static constexpr std::uint64_t rotateLeft(const std::uint64_t value, const int shift) noexcept {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    std::array<std::uint64_t, 4> m_state{};
+};
+
+/**
+ * @brief Seeded set of independent named random streams.
+ *
+ * Every stream is seeded from the session seed and a stable hash of its
+ * name, so adding a consumer of randomness never shifts the sequence
+ * another stream produces. Recording the seed is enough to replay a session.
+ */
+class RandomStreams {
+public:
+    /**
+     * @brief Constructs the streams.
+     *
+     * @param seed Session seed all streams are derived from.
+     */
+    explicit RandomStreams(const std::uint64_t seed = 0) noexcept
+        : m_seed{ seed }
+    {}
+
+    /**
+     * @brief Changes the session seed and restarts every stream from it.
+     */
+    void reseed(const std::uint64_t seed) noexcept;
+
+    /**
+     * @brief Returns a stream, creating it on first use.
+     *
+     * The reference stays valid until the RandomStreams object is destroyed.
+     *
+     * @param name Name identifying the stream.
+     */
+    [[nodiscard]] Xoshiro256& getStream(const std::string_view name);
+
+    [[nodiscard]] std::uint64_t getSeed() const noexcept {
+        return m_seed;
+    }
+
+private:
+    [[nodiscard]] static std::uint64_t getStreamSeed(const std::uint64_t seed, const std::string_view name) noexcept;
+
+    std::uint64_t m_seed{};
+    std::map<std::string, Xoshiro256, std::less<>> m_streams{};
+};
+
+#endif // RANDOM_H
@@ -8,7 +8,16 @@
 #define SETTINGS_H_CONFIG \
     X(bool, showFps, true) \
     X(float, gameSpeed, 1.f) \
-    X(float, volume, 1.f)
+    X(float, volume, 1.f) \
+    X(int, tickRate, 60) \
+    X(int, maxTicksPerFrame, 5) \
+    X(float, assetUploadBudgetMs, 2.f) \
+    X(int, modelCpuBudgetMb, 64) \
+    X(int, modelGpuBudgetMb, 256) \
+    X(bool, profilerEnabled, false) \
+    X(bool, exportFrameTimes, false) \
+    X(float, hitchBudgetMs, 0.f) \
+    X(bool, forbidSteadyStateAllocations, false)
 
 /**
  * @brief Application configuration container.
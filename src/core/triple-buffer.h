@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free handoff of the latest value from one producer thread to one consumer thread.
+ *
+ * The producer fills the write buffer and publishes it, the consumer
+ * acquires the most recently published buffer. Neither side ever waits
+ * for the other, values published in between two acquisitions are skipped.
+ * Buffers are reused, so values holding containers keep their capacity.
+ *
+ * @tparam T Value type, default constructible. The read buffer starts out
+ *         default constructed.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Returns the buffer owned by the producer.
+     *
+     * Holds the value published two publications ago, not the latest one.
+     */
+    [[nodiscard]] T& getWriteBuffer() noexcept {
+        return m_buffers[m_writeIndex];
+    }
+
+    /**
+     * @brief Hands the write buffer to the consumer and takes over the shared one.
+     */
+    void publish() noexcept {
+        const std::uint8_t previous{ m_sharedIndex.exchange(m_writeIndex | NewFlag, std::memory_order_acq_rel) };
+        m_writeIndex = previous & IndexMask;
+    }
+
+    /**
+     * @brief Makes the latest published value the read buffer.
+     *
+     * @return Whether a new value was published since the last call.
+     */
+    bool acquire() noexcept {
+        if (!(m_sharedIndex.load(std::memory_order_relaxed) & NewFlag)) {
+            return false;
+        }
+
+        const std::uint8_t previous{ m_sharedIndex.exchange(m_readIndex, std::memory_order_acq_rel) };
+        m_readIndex = previous & IndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Returns the buffer owned by the consumer.
+     */
+    [[nodiscard]] const T& getReadBuffer() const noexcept {
+        return m_buffers[m_readIndex];
+    }
+
+private:
+    static constexpr std::uint8_t IndexMask{ 0b011 };
+    static constexpr std::uint8_t NewFlag{ 0b100 };
+
+    std::array<T, 3> m_buffers{};
+    std::uint8_t m_writeIndex{ 0 };
+    std::atomic<std::uint8_t> m_sharedIndex{ 1 };
+    std::uint8_t m_readIndex{ 2 };
+};
+
+#endif // TRIPLE_BUFFER_H
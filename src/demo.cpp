@@ -4,11 +4,13 @@
 #include <core/settings.h>
 #include <core/audio-engine.h>
 #include <core/timer.h>
+#include <core/job-system.h>
 
 #include <renderer/shader.h>
 #include <renderer/material.h>
 #include <renderer/model.h>
 #include <renderer/model-store.h>
+#include <renderer/resource-registry.h>
 #include <renderer/lighting.h>
 #include <renderer/camera.h>
 #include <renderer/renderer.h>
@@ -36,17 +38,24 @@ static int runDemo() {
         camera.setAspectRatio(window.getFramebufferAspectRatio());
     });
 
-    ModelStore modelStore{};
+    JobSystem jobSystem{};
+    ModelStore modelStore{ jobSystem };
     constexpr auto objectPath{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Destroyer_01.fbx" };
     const auto object{ modelStore.load(objectPath, 0.0003f) };
     if (object != modelStore.load(objectPath, 0.0003f)) {
         std::cerr << "ModelStore failed to cache the object!\n";
         return -1;
     }
-    if (object == modelStore.load(objectPath, 1.f)) {
+    const auto scaledObject{ modelStore.load(objectPath, 1.f) };
+    if (object == scaledObject) {
         std::cerr << "ModelStore cached differently scaled objects!\n";
         return -1;
     }
+    const ResourceRegistry& resources{ modelStore.getResources() };
+    if (resources.get(object)->getGeometry() != resources.get(scaledObject)->getGeometry()) {
+        std::cerr << "ModelStore failed to share geometry between scales!\n";
+        return -1;
+    }
 
     FpsCounter fpsCounter{};
     InputManager inputManager{ window.getNativeHandle() };
@@ -79,8 +88,8 @@ static int runDemo() {
         model = glm::rotate(model, rotationAngle, glm::vec3{ 0.5f, 1.f, 0.f });
         model = glm::scale(model, glm::vec3{ modelScale });
 
-        renderer.beginFrame(lighting, camera);
-        renderer.draw(*object, model);
+        renderer.beginFrame(lighting, camera, resources);
+        renderer.draw(object, model);
         renderer.endFrame();
 
         ui::beginFrame();
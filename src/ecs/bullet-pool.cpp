@@ -0,0 +1,81 @@
+#include "bullet-pool.h"
+
+void BulletPool::reset(
+    entt::registry& registry,
+    const BulletPrefab& playerBullet,
+    const BulletPrefab& enemyBullet,
+    const std::size_t capacity
+) {
+    m_prefabs[static_cast<std::size_t>(EntityTypes::Player)] = playerBullet;
+    m_prefabs[static_cast<std::size_t>(EntityTypes::Enemy)] = enemyBullet;
+
+    const std::size_t bulletCount{ capacity * m_prefabs.size() };
+    registry.storage<Transform>().reserve(registry.storage<Transform>().size() + bulletCount);
+    registry.storage<PreviousTransform>().reserve(registry.storage<PreviousTransform>().size() + bulletCount);
+    registry.storage<Velocity>().reserve(registry.storage<Velocity>().size() + bulletCount);
+    registry.storage<Render>().reserve(registry.storage<Render>().size() + bulletCount);
+    registry.storage<Damage>().reserve(registry.storage<Damage>().size() + bulletCount);
+    registry.storage<FromWho>().reserve(bulletCount);
+    registry.storage<PlayerBulletTag>().reserve(capacity);
+    registry.storage<EnemyBulletTag>().reserve(capacity);
+
+    for (std::size_t type{}; type < m_prefabs.size(); ++type) {
+        auto& freeBullets{ m_freeBullets[type] };
+        freeBullets.clear();
+        freeBullets.reserve(capacity);
+
+        for (std::size_t i{}; i < capacity; ++i) {
+            freeBullets.push_back(createPooled(registry, m_prefabs[type]));
+        }
+    }
+}
+
+entt::entity BulletPool::spawn(
+    entt::registry& registry,
+    const EntityTypes fromWho,
+    const glm::vec3& position
+) {
+    const BulletPrefab& prefab{ m_prefabs[static_cast<std::size_t>(fromWho)] };
+    auto& freeBullets{ m_freeBullets[static_cast<std::size_t>(fromWho)] };
+
+    entt::entity entity{};
+    if (freeBullets.empty()) {
+        entity = createPooled(registry, prefab);
+    } else {
+        entity = freeBullets.back();
+        freeBullets.pop_back();
+    }
+
+    registry.emplace<Transform>(entity, position, prefab.rotation);
+    registry.emplace<Velocity>(entity, prefab.velocity);
+
+    if (fromWho == EntityTypes::Enemy) {
+        registry.emplace<EnemyBulletTag>(entity);
+    } else {
+        registry.emplace<PlayerBulletTag>(entity);
+    }
+
+    return entity;
+}
+
+bool BulletPool::release(entt::registry& registry, const entt::entity entity) {
+    const FromWho* const fromWho{ registry.try_get<FromWho>(entity) };
+    if (!fromWho) {
+        return false;
+    }
+
+    registry.remove<Transform, PreviousTransform, WorldTransform, Velocity, PlayerBulletTag, EnemyBulletTag>(entity);
+    m_freeBullets[static_cast<std::size_t>(fromWho->fromWho)].push_back(entity);
+
+    return true;
+}
+
+entt::entity BulletPool::createPooled(entt::registry& registry, const BulletPrefab& prefab) {
+    const entt::entity entity{ registry.create() };
+
+    registry.emplace<Render>(entity, prefab.object);
+    registry.emplace<Damage>(entity, prefab.damage);
+    registry.emplace<FromWho>(entity, prefab.fromWho);
+
+    return entity;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#ifndef BULLET_POOL_H
+#define BULLET_POOL_H
+
+#include "entities.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Recycles bullet entities instead of creating and destroying them.
+ *
+ * Pooled bullets keep their Render, Damage and FromWho components while
+ * inactive, firing only emplaces Transform, Velocity and the bullet tag
+ * into storage reserved up front. Once the pool has warmed up, firing
+ * neither allocates nor touches the model reference counts.
+ */
+class BulletPool {
+public:
+    /**
+     * @brief Number of bullets of each kind created up front.
+     */
+    static constexpr std::size_t defaultCapacity{ 64 };
+
+    /**
+     * @brief Creates the pooled entities and reserves component storage.
+     *
+     * Has to be called after the registry is cleared,
+     * previously pooled entities are forgotten.
+     *
+     * @param registry ECS registry the bullets live in.
+     * @param playerBullet Archetype of bullets fired by the player.
+     * @param enemyBullet Archetype of bullets fired by enemies.
+     * @param capacity Number of bullets of each kind created up front.
+     */
+    void reset(
+        entt::registry& registry,
+        const BulletPrefab& playerBullet,
+        const BulletPrefab& enemyBullet,
+        const std::size_t capacity = defaultCapacity
+    );
+
+    /**
+     * @brief Activates a pooled bullet, growing the pool if it is empty.
+     *
+     * @param registry ECS registry the bullets live in.
+     * @param fromWho Entity type that fired the bullet.
+     * @param position Initial bullet position.
+     * @return Activated bullet entity.
+     */
+    entt::entity spawn(
+        entt::registry& registry,
+        const EntityTypes fromWho,
+        const glm::vec3& position
+    );
+
+    /**
+     * @brief Returns a bullet to the pool.
+     *
+     * @param registry ECS registry the bullets live in.
+     * @param entity Entity to release.
+     * @return False if the entity is not a pooled bullet.
+     */
+    bool release(entt::registry& registry, const entt::entity entity);
+
+    /**
+     * @brief Returns the number of inactive bullets of a kind.
+     */
+    [[nodiscard]] std::size_t getFreeCount(const EntityTypes fromWho) const noexcept {
+        return m_freeBullets[static_cast<std::size_t>(fromWho)].size();
+    }
+
+private:
+    entt::entity createPooled(entt::registry& registry, const BulletPrefab& prefab);
+
+    std::array<BulletPrefab, 2> m_prefabs{};
+    std::array<std::vector<entt::entity>, 2> m_freeBullets{};
+};
+
+#endif // BULLET_POOL_H
@@ -0,0 +1,43 @@
+#include "collision-index.h"
+
+#include <algorithm>
+
+template <typename Tag>
+static void indexByLane(
+    const entt::registry& registry,
+    std::array<CollisionIndex::LaneBucket, Lane::laneCount>& lanes,
+    std::vector<CollisionIndex::Entry> CollisionIndex::LaneBucket::* const group
+) {
+    for (auto [entity, transform] : registry.view<Tag, Transform>().each()) {
+        const auto lane{ Lane::getLaneFromXPosition(transform.position.x) };
+        if (!lane) {
+            continue;
+        }
+
+        (lanes[static_cast<std::size_t>(*lane)].*group).push_back({ transform.position.z, entity });
+    }
+}
+
+void CollisionIndex::rebuild(const entt::registry& registry) {
+    for (auto& lane : m_lanes) {
+        lane.enemies.clear();
+        lane.playerBullets.clear();
+        lane.enemyBullets.clear();
+    }
+
+    indexByLane<EnemyTag>(registry, m_lanes, &LaneBucket::enemies);
+    indexByLane<PlayerBulletTag>(registry, m_lanes, &LaneBucket::playerBullets);
+    indexByLane<EnemyBulletTag>(registry, m_lanes, &LaneBucket::enemyBullets);
+
+    constexpr auto byZ{ [](const Entry& lhs, const Entry& rhs) { return lhs.z < rhs.z; } };
+    for (auto& lane : m_lanes) {
+        std::ranges::sort(lane.enemies, byZ);
+        std::ranges::sort(lane.playerBullets, byZ);
+        std::ranges::sort(lane.enemyBullets, byZ);
+    }
+}
+
+std::span<const CollisionIndex::Entry> CollisionIndex::fromZ(const std::vector<Entry>& entries, const float z) noexcept {
+    const auto first{ std::ranges::lower_bound(entries, z, {}, &Entry::z) };
+    return { first, entries.end() };
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef COLLISION_INDEX_H
+#define COLLISION_INDEX_H
+
+#include "components.h"
+
+#include <array>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Per-lane spatial index used for collision detection.
+ *
+ * Groups enemies and bullets by the lane they occupy and keeps every group
+ * sorted by Z, so that hits can be found with a single sweep per lane
+ * instead of testing every enemy against every bullet.
+ *
+ * The index is meant to be rebuilt once per tick, its buffers are reused
+ * between rebuilds to avoid reallocations.
+ */
+class CollisionIndex {
+public:
+    /**
+     * @brief Single indexed entity.
+     */
+    struct Entry {
+        float z{};             ///< World Z position at the time of the rebuild
+        entt::entity entity{}; ///< Indexed entity
+    };
+
+    /**
+     * @brief Entities occupying a single lane, each group sorted by ascending Z.
+     */
+    struct LaneBucket {
+        std::vector<Entry> enemies{};
+        std::vector<Entry> playerBullets{};
+        std::vector<Entry> enemyBullets{};
+    };
+
+    /**
+     * @brief Rebuilds the index from the current registry state.
+     *
+     * Entities positioned between lanes are not indexed.
+     *
+     * @param registry ECS registry containing all entities.
+     */
+    void rebuild(const entt::registry& registry);
+
+    /**
+     * @brief Returns indexed entities of a given lane.
+     */
+    [[nodiscard]] const LaneBucket& getLane(const Lane::Lane lane) const noexcept {
+        return m_lanes[static_cast<std::size_t>(lane)];
+    }
+
+    /**
+     * @brief Returns the entries of a sorted group whose Z is not lower than the given value.
+     */
+    [[nodiscard]] static std::span<const Entry> fromZ(const std::vector<Entry>& entries, const float z) noexcept;
+
+private:
+    std::array<LaneBucket, Lane::laneCount> m_lanes{};
+};
+
+#endif // !COLLISION_INDEX_H
@@ -0,0 +1,51 @@
+#include "command-buffer.h"
+#include "bullet-pool.h"
+
+#include <algorithm>
+
+void EntityCommandBuffer::spawnBullet(const EntityTypes fromWho, const glm::vec3& position) {
+    const std::lock_guard lock{ m_mutex };
+    m_bulletSpawns.push_back({ .fromWho{ fromWho }, .position{ position } });
+}
+
+void EntityCommandBuffer::destroy(const entt::entity entity) {
+    const std::lock_guard lock{ m_mutex };
+    if (!m_destroyed.contains(entity)) {
+        m_destroyed.push(entity);
+    }
+}
+
+void EntityCommandBuffer::flush(entt::registry& registry, BulletPool& bulletPool) {
+    // Sparse sets iterate from the most recently recorded entity.
+    m_destroyQueue.assign(m_destroyed.begin(), m_destroyed.end());
+    m_destroyed.clear();
+
+    std::erase_if(m_destroyQueue, [&registry, &bulletPool](const entt::entity entity) {
+        return !registry.valid(entity) || bulletPool.release(registry, entity);
+    });
+
+    registry.destroy(m_destroyQueue.begin(), m_destroyQueue.end());
+    m_destroyQueue.clear();
+
+    m_flushedSpawns.swap(m_bulletSpawns);
+    for (const BulletSpawn& spawn : m_flushedSpawns) {
+        bulletPool.spawn(registry, spawn.fromWho, spawn.position);
+    }
+    m_flushedSpawns.clear();
+}
+
+void EntityCommandBuffer::clear() {
+    const std::lock_guard lock{ m_mutex };
+    m_bulletSpawns.clear();
+    m_destroyed.clear();
+}
+
+std::size_t EntityCommandBuffer::getSpawnCount() const {
+    const std::lock_guard lock{ m_mutex };
+    return m_bulletSpawns.size();
+}
+
+std::size_t EntityCommandBuffer::getDestroyCount() const {
+    const std::lock_guard lock{ m_mutex };
+    return m_destroyed.size();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef COMMAND_BUFFER_H
+#define COMMAND_BUFFER_H
+
+#include "components.h"
+
+#include <entt/entity/registry.hpp>
+#include <entt/entity/sparse_set.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+class BulletPool;
+
+/**
+ * @brief Records structural registry changes and applies them in one batch at a sync point.
+ *
+ * Systems iterating the registry record bullet spawns and entity destruction
+ * here instead of changing storages under their own views. Commands are
+ * plain typed records, so recording does not allocate once the queues have
+ * grown to their working size. Recording is thread-safe. Destructions are
+ * deduplicated while recording, so marking an entity twice is cheap.
+ *
+ * Spawns are applied in recording order, which decides the pooled entities
+ * they reuse, so systems spawning bullets have to be ordered among themselves.
+ *
+ * flush() must not run concurrently with recording.
+ */
+class EntityCommandBuffer {
+public:
+    /**
+     * @brief Activates a pooled bullet on flush.
+     *
+     * @param fromWho Entity type firing the bullet.
+     * @param position Initial bullet position.
+     */
+    void spawnBullet(const EntityTypes fromWho, const glm::vec3& position);
+
+    /**
+     * @brief Destroys an entity on flush, before the spawns.
+     *
+     * Recording the same entity more than once has no further effect.
+     */
+    void destroy(const entt::entity entity);
+
+    /**
+     * @brief Destroys the recorded entities, then applies the recorded spawns.
+     *
+     * Entities are destroyed with a single range destroy, pooled bullets are
+     * returned to the pool instead, so the spawns can reuse them. Entities
+     * no longer valid are skipped.
+     *
+     * @param registry Registry the commands were recorded for.
+     * @param bulletPool Pool releasing destroyed bullets and activating spawned ones.
+     */
+    void flush(entt::registry& registry, BulletPool& bulletPool);
+
+    /**
+     * @brief Drops every recorded command, for when the registry is cleared.
+     */
+    void clear();
+
+    [[nodiscard]] std::size_t getSpawnCount() const;
+    [[nodiscard]] std::size_t getDestroyCount() const;
+
+private:
+    struct BulletSpawn {
+        EntityTypes fromWho{};
+        glm::vec3 position{};
+    };
+
+    mutable std::mutex m_mutex{};
+    std::vector<BulletSpawn> m_bulletSpawns{};
+    entt::sparse_set m_destroyed{};
+
+    /// Kept between flushes to reuse their capacity.
+    std::vector<BulletSpawn> m_flushedSpawns{};
+    std::vector<entt::entity> m_destroyQueue{};
+};
+
+#endif // COMMAND_BUFFER_H
@@ -5,7 +5,11 @@
 
 #include "entt/entt.hpp"
 #include "glm/glm.hpp"
-#include "../renderer/model.h"
+#include "../renderer/resource-handle.h"
+
+#include <cmath>
+#include <cstddef>
+#include <optional>
 
 /**
  * @brief Contains lane related enums and helper functions.
@@ -69,6 +73,31 @@ namespace Lane {
             return 0.f;
         }
     }
+
+    /**
+     * @brief Number of lanes an entity can occupy.
+     */
+    inline constexpr std::size_t laneCount{ 3 };
+
+    /**
+     * @brief Finds the lane whose center matches the given X position.
+     *
+     * Entities moving between lanes do not belong to any of them.
+     *
+     * @param x World X coordinate
+     * @return Lane at the given position or std::nullopt when between lanes
+     */
+    inline std::optional<Lane> getLaneFromXPosition(float x) {
+        constexpr float tolerance{ 0.01f };
+
+        for (Lane lane : { Lane::Left, Lane::Middle, Lane::Right }) {
+            if (std::abs(x - getLaneXPosition(lane)) <= tolerance) {
+                return lane;
+            }
+        }
+
+        return std::nullopt;
+    }
 };
 
 enum class EntityTypes {
@@ -81,6 +110,27 @@ struct Transform {
     glm::vec3 rotation{};
 };
 
+/**
+ * @brief Transform at the start of the latest simulation step.
+ *
+ * Used to interpolate rendered positions between simulation steps.
+ */
+struct PreviousTransform {
+    glm::vec3 position{};
+    glm::vec3 rotation{};
+};
+
+/**
+ * @brief World matrix of the Transform at the end of the latest simulation step.
+ *
+ * Maintained by worldTransformSystem(), which rebuilds the rotation part
+ * only when Transform::rotation differs from the angles it was built from.
+ */
+struct WorldTransform {
+    glm::mat4 matrix{ 1.f };
+    glm::vec3 rotation{}; ///< Euler angles in degrees the rotation part was built from
+};
+
 struct Health {
     int max;
     int current;
@@ -90,12 +140,21 @@ struct Damage {
     int current{ 1 };
 };
 
+/**
+ * @brief Rate of change of a Transform.
+ *
+ * Mirrors the layout of Transform, so movementSystem() can integrate
+ * both as parallel float arrays. Both fields are scaled by the movement
+ * speed factor of movementSystem(), so the actual rate per second is
+ * that factor times the stored value.
+ */
 struct Velocity {
-    glm::vec3 linear{ 0.0f, 0.0f, 0.0f };
+    glm::vec3 linear{ 0.0f, 0.0f, 0.0f };  ///< Position change for each axis, before the speed factor
+    glm::vec3 angular{ 0.0f, 0.0f, 0.0f }; ///< Degrees for each Euler angle, before the speed factor
 };
 
 struct Render {
-    std::shared_ptr<Model> object;
+    ModelHandle object{};
 };
 
 /**
@@ -131,7 +190,6 @@ struct FromWho {
     EntityTypes fromWho; ///< Type of entity that fired the bullet.
 };
 
-struct DestroyTag {};
 struct PlayerTag {};
 struct EnemyTag {};
 struct EnemyBulletTag {};
@@ -1,8 +1,68 @@
 #include "entities.h"
-#include <renderer/model.h>
 #include <renderer/model-store.h>
 
-entt::entity createPlayer(entt::registry& registry, std::shared_ptr<Model> object, const glm::vec3& position) {
+const EnemyPrefab& Prefabs::getEnemy(const EnemyType enemyType) const noexcept {
+    switch (enemyType) {
+    case EnemyType::Slim:
+        return slimEnemy;
+    case EnemyType::Bulky:
+        return bulkyEnemy;
+    case EnemyType::Basic:
+    default:
+        return basicEnemy;
+    }
+}
+
+Prefabs resolvePrefabs(ModelStore& modelStore) {
+    // Bullets are needed on the first shot. Enemies spawn mid-level,
+    // so their models may show up once uploaded instead of stalling the frame.
+    const ModelHandle bullet{ modelStore.load(EntityModels::bullet, EntityModels::bulletScale) };
+
+    return {
+        .basicEnemy{
+            .object{ modelStore.loadAsync(EntityModels::basicEnemy, EntityModels::shipScale) },
+            .velocity{ 0.f, 0.f, 0.4f },
+            .health{ 50 },
+            .damage{ 30 },
+        },
+        .slimEnemy{
+            .object{ modelStore.loadAsync(EntityModels::slimEnemy, EntityModels::shipScale) },
+            .velocity{ 0.f, 0.f, 1.5f },
+            .health{ 30 },
+            .damage{ 30 },
+        },
+        .bulkyEnemy{
+            .object{ modelStore.loadAsync(EntityModels::bulkyEnemy, EntityModels::shipScale) },
+            .velocity{ 0.f, 0.f, 0.1f },
+            .health{ 80 },
+            .damage{ 30 },
+        },
+        .playerBullet{
+            .object{ bullet },
+            .rotation{ -90.f, 0.f, 0.f },
+            .velocity{ 0.f, 0.f, -1.f },
+            .damage{ 30 },
+            .fromWho{ EntityTypes::Player },
+        },
+        .enemyBullet{
+            .object{ bullet },
+            .rotation{ 90.f, 0.f, 0.f },
+            .velocity{ 0.f, 0.f, 2.f },
+            .damage{ 10 },
+            .fromWho{ EntityTypes::Enemy },
+        },
+    };
+}
+
+void pinEntityModels(ModelStore& modelStore) {
+    modelStore.pin(EntityModels::player);
+    modelStore.pin(EntityModels::basicEnemy);
+    modelStore.pin(EntityModels::slimEnemy);
+    modelStore.pin(EntityModels::bulkyEnemy);
+    modelStore.pin(EntityModels::bullet);
+}
+
+entt::entity createPlayer(entt::registry& registry, const ModelHandle object, const glm::vec3& position) {
     entt::entity entity = registry.create();
 
     registry.emplace<Transform>(entity, position, glm::vec3{ 0.f, -90.f, 0.f });
@@ -16,65 +76,18 @@ entt::entity createPlayer(entt::registry& registry, std::shared_ptr<Model> objec
     return entity;
 }
 
-entt::entity createEntity(entt::registry& registry, EnemyType enemyType, ModelStore& modelStore, Lane::Lane& lane) {
-
+entt::entity createEntity(entt::registry& registry, const EnemyPrefab& prefab, const Lane::Lane lane) {
     entt::entity entity = registry.create();
-    std::shared_ptr<Model> object;
     glm::vec3 position{ Lane::getLaneXPosition(lane), -2.0f, -40.0f};
-    glm::vec3 velocity{0.0f, 0.0f, 0.4f};
-    int health{ 50 };
-
-    constexpr auto basicEnemy{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Destroyer_01.fbx" };
-    constexpr auto slimEnemy{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Light_cruiser_05.fbx" };
-    constexpr auto bulkyEnemy{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Destroyer_04.fbx" };
-
-    switch (enemyType) {
-    case EnemyType::Basic:
-        object = modelStore.load(basicEnemy, 0.0003f);
-        break;
-    case EnemyType::Slim:
-        object = modelStore.load(slimEnemy, 0.0003f);
-        velocity.z = 1.5f;
-        health = 30;
-        break;
-    case EnemyType::Bulky:
-        object = modelStore.load(bulkyEnemy, 0.0003f);
-        velocity.z = 0.1f;
-        health = 80;
-        break;
-    default:
-        break;
-    }
 
     registry.emplace<Transform>(entity, position, glm::vec3{0.f, 90.f, 0.f});
-    registry.emplace<Velocity>(entity, velocity);
-    registry.emplace<Health>(entity, health, health);
-    registry.emplace<Render>(entity, std::move(object));
-    registry.emplace<Damage>(entity, 30);
+    registry.emplace<Velocity>(entity, prefab.velocity);
+    registry.emplace<Health>(entity, prefab.health, prefab.health);
+    registry.emplace<Render>(entity, prefab.object);
+    registry.emplace<Damage>(entity, prefab.damage);
     registry.emplace<TimeDelay>(entity);
     registry.emplace<Stats>(entity);
     registry.emplace<EnemyTag>(entity);
 
-    return entity;
-}
-
-entt::entity createBullet(entt::registry& registry, const EntityTypes fromWho, std::shared_ptr<Model> object, glm::vec3& position, const glm::vec3& rotation, const glm::vec3& velocity) {
-    entt::entity entity = registry.create();
-    int damage{ 10 };
-
-    if (fromWho == EntityTypes::Enemy) {
-        registry.emplace<EnemyBulletTag>(entity);
-    }
-    else {
-        registry.emplace<PlayerBulletTag>(entity);
-        damage = 30;
-    }
-
-    registry.emplace<Transform>(entity, position, rotation);
-    registry.emplace<Velocity>(entity, velocity);
-    registry.emplace<Render>(entity, object);
-    registry.emplace<Damage>(entity, damage);
-
-
     return entity;
 }
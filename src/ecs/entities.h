@@ -4,7 +4,6 @@
 #define ENTITIES_H
 
 #include "components.h"
-class Model;
 class ModelStore;
 
 /**
@@ -16,6 +15,77 @@ enum class EnemyType {
     Bulky  ///< Slow enemy with higher health
 };
 
+/**
+ * @brief Model files and scales used by the entities.
+ */
+namespace EntityModels {
+    inline constexpr auto player{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Destroyer_01.fbx" };
+    inline constexpr auto basicEnemy{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Destroyer_01.fbx" };
+    inline constexpr auto slimEnemy{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Light_cruiser_05.fbx" };
+    inline constexpr auto bulkyEnemy{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Destroyer_04.fbx" };
+    inline constexpr auto bullet{ "assets/3d-models/bullet.obj" };
+
+    inline constexpr float shipScale{ 0.0003f };
+    inline constexpr float bulletScale{ 0.1f };
+}
+
+/**
+ * @brief Pre-resolved description of an enemy type.
+ */
+struct EnemyPrefab {
+    ModelHandle object{};
+    glm::vec3 velocity{};
+    int health{};
+    int damage{};
+};
+
+/**
+ * @brief Pre-resolved description of a bullet fired by a player or an enemy.
+ */
+struct BulletPrefab {
+    ModelHandle object{};
+    glm::vec3 rotation{};
+    glm::vec3 velocity{};
+    int damage{};
+    EntityTypes fromWho{};
+};
+
+/**
+ * @brief Archetypes of every spawnable entity.
+ *
+ * Models are resolved once, so spawning does not touch the ModelStore.
+ */
+struct Prefabs {
+    EnemyPrefab basicEnemy{};
+    EnemyPrefab slimEnemy{};
+    EnemyPrefab bulkyEnemy{};
+    BulletPrefab playerBullet{};
+    BulletPrefab enemyBullet{};
+
+    [[nodiscard]] const EnemyPrefab& getEnemy(const EnemyType enemyType) const noexcept;
+};
+
+/**
+ * @brief Resolves the models and stats of every spawnable entity.
+ *
+ * Enemy models are loaded asynchronously, see ModelStore::loadAsync().
+ *
+ * @param modelStore Model storage used by the entities.
+ *
+ * @throws std::runtime_error If the bullet model fails to load.
+ */
+[[nodiscard]] Prefabs resolvePrefabs(ModelStore& modelStore);
+
+/**
+ * @brief Pins every entity model in the store and starts loading it.
+ *
+ * Keeps ship and bullet geometry resident for the whole session,
+ * so repeated waves never reload it from disk.
+ *
+ * @param modelStore Model storage used by the entities.
+ */
+void pinEntityModels(ModelStore& modelStore);
+
 /**
  * @brief Creates a player entity and assigns all required player components.
  *
@@ -23,39 +93,20 @@ enum class EnemyType {
  * timing, statistics and player tag components.
  *
  * @param registry Reference to the EnTT registry.
- * @param object Shared pointer to the player model.
+ * @param object Handle of the player model.
  * @param position Initial world position of the player.
  * @return Created player entity.
  */
-entt::entity createPlayer(entt::registry& registry, std::shared_ptr<Model> object, const glm::vec3& position);
+entt::entity createPlayer(entt::registry& registry, const ModelHandle object, const glm::vec3& position);
 
 /**
- * @brief Creates an enemy entity based on the specified enemy type.
- *
- * Enemy properties such as model, health and movement speed depend
- * on the provided EnemyType.
+ * @brief Creates an enemy entity from a prefab.
  *
  * @param registry Reference to the EnTT registry.
- * @param enemyType Type of enemy to create.
- * @param modelStore Model storage used to load enemy models.
+ * @param prefab Enemy archetype to instantiate.
  * @param lane Lane in which the enemy should be spawned.
  * @return Created enemy entity.
  */
-entt::entity createEntity(entt::registry& registry, EnemyType enemyType, ModelStore& modelStore, Lane::Lane& lane);
-
-/**
- * @brief Creates a bullet entity fired by a player or an enemy.
- *
- * The bullet damage and tag depend on the source entity type.
- *
- * @param registry Reference to the EnTT registry.
- * @param fromWho Entity type that fired the bullet.
- * @param object Shared pointer to the bullet model.
- * @param position Initial bullet position.
- * @param rotation Initial bullet rotation.
- * @param velocity Bullet movement velocity.
- * @return Created bullet entity.
- */
-entt::entity createBullet(entt::registry& registry, const EntityTypes fromWho, std::shared_ptr<Model> object, glm::vec3& position, const glm::vec3& rotation, const glm::vec3& velocity);
+entt::entity createEntity(entt::registry& registry, const EnemyPrefab& prefab, const Lane::Lane lane);
 
 #endif // !ENTITIES_H
@@ -0,0 +1,42 @@
+#pragma once
+
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "components.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Entity drawn by a snapshot, with the data needed to interpolate it.
+ */
+struct RenderInstance {
+    ModelHandle object{};
+    glm::mat4 world{ 1.f };         ///< Cached world matrix of the latest step
+    glm::vec3 rotation{};           ///< Euler angles the world matrix was built from
+    glm::vec3 previousPosition{};   ///< Position before the latest step
+    glm::vec3 previousRotation{};   ///< Euler angles before the latest step
+    bool isInterpolated{};          ///< Whether the previous transform is known
+};
+
+/**
+ * @brief Immutable copy of everything a frame needs from the simulation.
+ *
+ * Captured on the simulation thread after a batch of steps, so the render
+ * thread draws and fills the HUD without touching the live registry.
+ */
+struct RenderSnapshot {
+    std::vector<RenderInstance> instances{};
+
+    Health playerHealth{};
+    Stats playerStats{};
+    std::size_t currentLevel{};
+
+    /// Interpolation factor between the previous (0) and latest (1) step.
+    float alpha{ 1.f };
+};
+
+#endif // RENDER_SNAPSHOT_H
@@ -0,0 +1,112 @@
+#include "system-scheduler.h"
+
+#include <core/job-system.h>
+#include <core/profiler.h>
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const noexcept {
+    if (m_isExclusive || other.m_isExclusive) {
+        return true;
+    }
+
+    const auto overlaps{ [](const std::vector<entt::id_type>& lhs, const std::vector<entt::id_type>& rhs) {
+        return std::ranges::any_of(lhs, [&rhs](const entt::id_type id) { return std::ranges::find(rhs, id) != rhs.end(); });
+    } };
+
+    return overlaps(m_writes, other.m_writes)
+        || overlaps(m_writes, other.m_reads)
+        || overlaps(m_reads, other.m_writes);
+}
+
+void SystemScheduler::add(std::string name, SystemAccess access, std::function<void()> system) {
+    const std::size_t index{ m_systems.size() };
+
+    System entry{
+        .name{ std::move(name) },
+        .access{ std::move(access) },
+        .run{ std::move(system) },
+    };
+
+    for (std::size_t earlier{}; earlier < index; ++earlier) {
+        if (m_systems[earlier].access.conflictsWith(entry.access)) {
+            entry.dependencies.push_back(earlier);
+            m_systems[earlier].dependents.push_back(index);
+        }
+    }
+
+    m_systems.push_back(std::move(entry));
+    m_preparedRegistry = nullptr;
+}
+
+void SystemScheduler::run(entt::registry& registry, JobSystem& jobSystem) {
+    if (m_preparedRegistry != &registry) {
+        for (const auto& system : m_systems) {
+            for (const auto initializeStorage : system.access.m_storageInitializers) {
+                initializeStorage(registry);
+            }
+        }
+        m_preparedRegistry = &registry;
+    }
+
+    if (m_remainingDependencies.size() != m_systems.size()) {
+        m_remainingDependencies = std::vector<std::atomic<std::size_t>>(m_systems.size());
+    }
+
+    for (std::size_t i{}; i < m_systems.size(); ++i) {
+        m_remainingDependencies[i].store(m_systems[i].dependencies.size(), std::memory_order_relaxed);
+    }
+
+    m_unfinishedCount.store(m_systems.size());
+    m_hasFailed.store(false);
+    m_error = nullptr;
+
+    for (std::size_t i{}; i < m_systems.size(); ++i) {
+        if (m_systems[i].dependencies.empty()) {
+            jobSystem.schedule([this, &jobSystem, i] { runSystem(jobSystem, i); });
+        }
+    }
+
+    jobSystem.helpUntil([this] { return m_unfinishedCount.load(std::memory_order_acquire) == 0; });
+
+    if (m_error) {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+}
+
+void SystemScheduler::runSystem(JobSystem& jobSystem, const std::size_t system) noexcept {
+    if (!m_hasFailed.load()) {
+        PROFILE_ZONE(m_systems[system].name.c_str());
+        std::exception_ptr error{};
+
+        try {
+            m_systems[system].run();
+        } catch (const std::exception& exception) {
+            error = std::make_exception_ptr(std::runtime_error{
+                std::format("System {} failed: {}", m_systems[system].name, exception.what())
+            });
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        if (error) {
+            const std::lock_guard lock{ m_errorMutex };
+            if (!m_error) {
+                m_error = error;
+            }
+            m_hasFailed.store(true);
+        }
+    }
+
+    // Skipped systems still release their dependents, so the run drains.
+    for (const std::size_t dependent : m_systems[system].dependents) {
+        if (m_remainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            jobSystem.schedule([this, &jobSystem, dependent] { runSystem(jobSystem, dependent); });
+        }
+    }
+
+    m_unfinishedCount.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#ifndef SYSTEM_SCHEDULER_H
+#define SYSTEM_SCHEDULER_H
+
+#include <entt/core/type_info.hpp>
+#include <entt/entity/registry.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @brief Declared data access of a system.
+ *
+ * Component types are the storages a system reads or writes, including
+ * components it only emplaces or removes. Resource types stand for any
+ * other shared state, by convention entt::entity for creating entities.
+ */
+class SystemAccess {
+public:
+    template <typename... Components>
+    SystemAccess& read() {
+        (addComponent<Components>(m_reads), ...);
+        return *this;
+    }
+
+    template <typename... Components>
+    SystemAccess& write() {
+        (addComponent<Components>(m_writes), ...);
+        return *this;
+    }
+
+    template <typename... Resources>
+    SystemAccess& readResource() {
+        (m_reads.push_back(entt::type_hash<Resources>::value()), ...);
+        return *this;
+    }
+
+    template <typename... Resources>
+    SystemAccess& writeResource() {
+        (m_writes.push_back(entt::type_hash<Resources>::value()), ...);
+        return *this;
+    }
+
+    /**
+     * @brief Marks the system as conflicting with every other system.
+     *
+     * Meant for systems destroying entities, which touches every storage.
+     */
+    SystemAccess& exclusive() noexcept {
+        m_isExclusive = true;
+        return *this;
+    }
+
+    /**
+     * @brief Returns whether two systems must not run concurrently.
+     */
+    [[nodiscard]] bool conflictsWith(const SystemAccess& other) const noexcept;
+
+private:
+    friend class SystemScheduler;
+
+    template <typename Component>
+    void addComponent(std::vector<entt::id_type>& ids) {
+        ids.push_back(entt::type_hash<Component>::value());
+        m_storageInitializers.push_back([](entt::registry& registry) { registry.storage<Component>(); });
+    }
+
+    std::vector<entt::id_type> m_reads{};
+    std::vector<entt::id_type> m_writes{};
+    std::vector<void (*)(entt::registry&)> m_storageInitializers{};
+    bool m_isExclusive{};
+};
+
+/**
+ * @brief Runs systems concurrently where their declared access allows it.
+ *
+ * Systems are registered in their serial order. A system depends on every
+ * earlier system it conflicts with, which yields a DAG run as jobs on a
+ * JobSystem, with the calling thread taking part. As long as the access
+ * declarations are complete, every run produces the same results
+ * as calling the systems one after another.
+ */
+class SystemScheduler {
+public:
+    SystemScheduler() = default;
+
+    SystemScheduler(const SystemScheduler&) = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    SystemScheduler(SystemScheduler&&) = delete;
+    SystemScheduler& operator=(SystemScheduler&&) = delete;
+
+    /**
+     * @brief Appends a system after the already registered ones.
+     *
+     * @param name Name of the system, used in error messages.
+     * @param access Components and resources the system touches.
+     * @param system Function running the system.
+     */
+    void add(std::string name, SystemAccess access, std::function<void()> system);
+
+    /**
+     * @brief Runs every system once and waits for all of them.
+     *
+     * Storages of all declared components are created up front, so the
+     * systems never modify the registry's storage table concurrently.
+     * If a system throws, the systems that have not started yet are
+     * skipped and the first error is rethrown once the others finished.
+     *
+     * @param registry Registry the systems operate on.
+     * @param jobSystem Workers helping the calling thread.
+     */
+    void run(entt::registry& registry, JobSystem& jobSystem);
+
+    [[nodiscard]] std::size_t getSystemCount() const noexcept {
+        return m_systems.size();
+    }
+
+    /**
+     * @brief Returns the indices of the systems a system waits for.
+     */
+    [[nodiscard]] const std::vector<std::size_t>& getDependencies(const std::size_t system) const noexcept {
+        return m_systems[system].dependencies;
+    }
+
+private:
+    struct System {
+        std::string name{};
+        SystemAccess access{};
+        std::function<void()> run{};
+        std::vector<std::size_t> dependencies{};
+        std::vector<std::size_t> dependents{};
+    };
+
+    /**
+     * @brief Runs a system, then schedules the dependents it was the last dependency of.
+     */
+    void runSystem(JobSystem& jobSystem, const std::size_t system) noexcept;
+
+    std::vector<System> m_systems{};
+    entt::registry* m_preparedRegistry{};
+
+    std::vector<std::atomic<std::size_t>> m_remainingDependencies{};
+    std::atomic<std::size_t> m_unfinishedCount{};
+    std::atomic<bool> m_hasFailed{};
+
+    std::mutex m_errorMutex{};
+    std::exception_ptr m_error{};
+};
+
+#endif // SYSTEM_SCHEDULER_H
@@ -1,53 +1,147 @@
 #include "systems.h"
+#include "collision-index.h"
+#include "bullet-pool.h"
+#include "command-buffer.h"
 
 #include <renderer/renderer.h>
-#include <renderer/model-store.h>
-#include <core/input-manager.h>
-#include <core/audio-engine.h>
+#include <core/input-state.h>
+#include <core/random.h>
+#include <core/batch-math.h>
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
-#include <random>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <type_traits>
 
 #include <iostream>
 
+/**
+ * @brief Builds the rotation matrix of Euler angles applied in the X, Y, Z order.
+ */
+[[nodiscard]] static glm::mat4 makeRotation(const glm::vec3& degrees) noexcept {
+    const glm::vec3 radians{ glm::radians(degrees) };
+    const glm::quat rotation{
+        glm::angleAxis(radians.x, glm::vec3{ 1.f, 0.f, 0.f })
+        * glm::angleAxis(radians.y, glm::vec3{ 0.f, 1.f, 0.f })
+        * glm::angleAxis(radians.z, glm::vec3{ 0.f, 0.f, 1.f })
+    };
+
+    return glm::mat4_cast(rotation);
+}
+
 void movementSystem(entt::registry& registry, const float deltaTime) {
-    entt::basic_view view = registry.view<Transform, Velocity>();
+    // Both components are plain float arrays of the same shape,
+    // so position += linear and rotation += angular is one element-wise operation.
+    static_assert(sizeof(Transform) == 6 * sizeof(float) && std::is_standard_layout_v<Transform>);
+    static_assert(sizeof(Velocity) == sizeof(Transform) && std::is_standard_layout_v<Velocity>);
 
+    constexpr std::size_t pageSize{ entt::component_traits<Transform>::page_size };
+    static_assert(pageSize == entt::component_traits<Velocity>::page_size);
+
+    // Shared by linear and angular velocity, see the movementSystem() documentation.
     const float speed{ 5.f };
 
-    for (auto [entity, transform, velocity]: view.each()) {
-        transform.position += velocity.linear * deltaTime * speed;
+    auto group{ registry.group<Transform, Velocity>() };
+    Transform* const* const transformPages{ group.storage<Transform>()->raw() };
+    const Velocity* const* const velocityPages{ group.storage<Velocity>()->raw() };
+
+    for (std::size_t first{}; first < group.size(); first += pageSize) {
+        const std::size_t count{ std::min(pageSize, group.size() - first) };
+
+        multiplyAdd(
+            { reinterpret_cast<float*>(transformPages[first / pageSize]), count * 6 },
+            { reinterpret_cast<const float*>(velocityPages[first / pageSize]), count * 6 },
+            deltaTime * speed
+        );
     }
 }
 
-void renderingSystem(entt::registry& registry, Renderer& renderer) {
-    entt::basic_view view = registry.view<Render, Transform>();
+void storePreviousTransformSystem(entt::registry& registry) {
+    entt::basic_view view = registry.view<Transform, PreviousTransform>();
+
+    for (auto [entity, transform, previous] : view.each()) {
+        previous.position = transform.position;
+        previous.rotation = transform.rotation;
+    }
 
-    for (auto [entity, render, transform] : view.each()) {
+    // Entities created since the last step.
+    auto& previousStorage{ registry.storage<PreviousTransform>() };
+    for (auto [entity, transform] : registry.view<Transform>().each()) {
+        if (!previousStorage.contains(entity)) {
+            previousStorage.emplace(entity, transform.position, transform.rotation);
+        }
+    }
+}
 
-        //std::cout << transform.position.x << " " << transform.position.y << " " << transform.position.z << "\n";
+void worldTransformSystem(entt::registry& registry) {
+    entt::basic_view view = registry.view<Transform, WorldTransform>();
 
-        glm::mat4 model{ 1.f };
-        model = glm::translate(model, transform.position);
-        model = glm::rotate(model, glm::radians(transform.rotation.x), glm::vec3{ 1.f, 0.f, 0.f });
-        model = glm::rotate(model, glm::radians(transform.rotation.y), glm::vec3{ 0.f, 1.f, 0.f });
-        model = glm::rotate(model, glm::radians(transform.rotation.z), glm::vec3{ 0.f, 0.f, 1.f });
+    for (auto [entity, transform, world] : view.each()) {
+        if (world.rotation != transform.rotation) {
+            world.matrix = makeRotation(transform.rotation);
+            world.rotation = transform.rotation;
+        }
+        world.matrix[3] = glm::vec4{ transform.position, 1.f };
+    }
 
-        renderer.draw(*render.object, model);
+    // Entities created since the last step.
+    auto& worldStorage{ registry.storage<WorldTransform>() };
+    for (auto [entity, transform] : registry.view<Transform>().each()) {
+        if (!worldStorage.contains(entity)) {
+            WorldTransform& world{ worldStorage.emplace(entity, makeRotation(transform.rotation), transform.rotation) };
+            world.matrix[3] = glm::vec4{ transform.position, 1.f };
+        }
     }
 }
 
-void cleanUpSystem(entt::registry& registry) {
-    entt::basic_view view = registry.view<DestroyTag>();
+void snapshotSystem(const entt::registry& registry, RenderSnapshot& snapshot) {
+    snapshot.instances.clear();
+
+    for (auto [entity, render, world] : registry.view<Render, WorldTransform>().each()) {
+        RenderInstance& instance{ snapshot.instances.emplace_back() };
+        instance.object = render.object;
+        instance.world = world.matrix;
+        instance.rotation = world.rotation;
 
-    for (auto [entity] : view.each()) {
-        registry.destroy(entity);
+        if (const auto* const previous{ registry.try_get<PreviousTransform>(entity) }) {
+            instance.previousPosition = previous->position;
+            instance.previousRotation = previous->rotation;
+            instance.isInterpolated = true;
+        }
+    }
+
+    const auto players{ registry.view<PlayerTag>() };
+    if (players.begin() != players.end()) {
+        snapshot.playerHealth = registry.get<Health>(players.front());
+        snapshot.playerStats = registry.get<Stats>(players.front());
     }
 }
 
-void playerInputSystem(entt::registry& registry, const InputManager& inputManager, ModelStore& modelStore, AudioEngine& audioEngine, const float deltaTime) {
+void renderingSystem(const RenderSnapshot& snapshot, Renderer& renderer) {
+    for (const RenderInstance& instance : snapshot.instances) {
+        if (!instance.isInterpolated) {
+            renderer.draw(instance.object, instance.world);
+            continue;
+        }
+
+        glm::mat4 model{ instance.world };
+        if (instance.previousRotation != instance.rotation) {
+            model = makeRotation(glm::mix(instance.previousRotation, instance.rotation, snapshot.alpha));
+        }
+        model[3] = glm::vec4{ glm::mix(instance.previousPosition, glm::vec3{ instance.world[3] }, snapshot.alpha), 1.f };
+
+        renderer.draw(instance.object, model);
+    }
+}
+
+void cleanUpSystem(entt::registry& registry, EntityCommandBuffer& commands, BulletPool& bulletPool) {
+    commands.flush(registry, bulletPool);
+}
+
+bool playerInputSystem(entt::registry& registry, const InputState& inputState, EntityCommandBuffer& commands, const float deltaTime) {
     constexpr float animationTime{ 0.3f };
     constexpr float bulletDelay{ 1.0f };
 
@@ -56,12 +150,13 @@ void playerInputSystem(entt::registry& registry, const InputManager& inputManage
     Transform& transform{ registry.get<Transform>(player) };
     TimeDelay& timeDelay{ registry.get<TimeDelay>(player) };
     Stats& stats{ registry.get<Stats>(player) };
+    bool hasFired{};
 
     if (animation.animationTime <= 0.0f) {
         Lane::Lane newLane{animation.currentLane};
 
-        bool aPressed{ inputManager.isDown(InputManager::Key::A) };
-        bool dPressed{ inputManager.isDown(InputManager::Key::D) };
+        bool aPressed{ inputState.isDown(InputState::Key::A) };
+        bool dPressed{ inputState.isDown(InputState::Key::D) };
 
         if (aPressed && !dPressed) {
             newLane = Lane::changeLane(animation.currentLane, Lane::LaneDirection::Left);
@@ -79,14 +174,12 @@ void playerInputSystem(entt::registry& registry, const InputManager& inputManage
             timeDelay.shootingDelay -= deltaTime;
         }
 
-        if (inputManager.isDown(InputManager::Key::Space) && timeDelay.shootingDelay <= 0.0f) {
+        if (inputState.isDown(InputState::Key::Space) && timeDelay.shootingDelay <= 0.0f) {
             //std::cout << "Działa\n";
-            constexpr auto path{ "assets/3d-models/bullet.obj" };
-            glm::vec3 velocity{ 0.0f, 0.0f, -1.0f };
-            createBullet(registry, EntityTypes::Player, modelStore.load(path, 0.1f), transform.position, glm::vec3{-90.0f, 0.0f, 0.0f}, velocity);
-            audioEngine.play("assets/sounds/space-laser.mp3");
+            commands.spawnBullet(EntityTypes::Player, transform.position);
             timeDelay.shootingDelay = bulletDelay;
             stats.firedBullets += 1;
+            hasFired = true;
         }
     }
 
@@ -106,6 +199,8 @@ void playerInputSystem(entt::registry& registry, const InputManager& inputManage
             transform.position.x = std::lerp(startX, targetX, t);
         }
     }
+
+    return hasFired;
 }
 
 void restorePlayerHealthSystem(entt::registry& registry) {
@@ -114,7 +209,7 @@ void restorePlayerHealthSystem(entt::registry& registry) {
     health.current = health.max;
 }
 
-void receivingDamageSystem(entt::registry& registry, const float deltaTime) {
+void receivingDamageSystem(entt::registry& registry, CollisionIndex& collisionIndex, EntityCommandBuffer& commands, const float deltaTime) {
     constexpr float invincibilityTime{ 1.0f };
 
     auto player = registry.view<PlayerTag>().front();
@@ -123,40 +218,52 @@ void receivingDamageSystem(entt::registry& registry, const float deltaTime) {
     Transform transform{ registry.get<Transform>(player) };
     Stats& stats{ registry.get<Stats>(player) };
 
+    // Bullets that left the playfield.
+    for (auto [bulletEntity, bulletTransform] : registry.view<PlayerBulletTag, Transform>().each()) {
+        if (bulletTransform.position.z < -40) {
+            commands.destroy(bulletEntity);
+        }
+    }
+
+    for (auto [bulletEntity, bulletTransform] : registry.view<EnemyBulletTag, Transform>().each()) {
+        if (bulletTransform.position.z > 0) {
+            commands.destroy(bulletEntity);
+        }
+    }
+
+    collisionIndex.rebuild(registry);
 
-    auto enemy = registry.view<EnemyTag, Transform, Damage, Health>();
-    auto enemyBullet = registry.view<EnemyBulletTag, Transform, Damage>();
-    auto playerBullet = registry.view<PlayerBulletTag, Transform, Damage>();
+    // Enemies recieving damage from players bullets, swept lane by lane.
+    // Both groups are sorted by z, so each bullet hits the closest living enemy it has reached.
+    for (std::size_t laneIdx{}; laneIdx < Lane::laneCount; ++laneIdx) {
+        const auto& lane{ collisionIndex.getLane(static_cast<Lane::Lane>(laneIdx)) };
+        auto enemyIt{ lane.enemies.begin() };
 
-    for (auto [enemyEntity, enemyTransform, damage, enemyHealth] : enemy.each()) {
-        for (auto [bulletEntity, bulletTransform, bulletDamage] : playerBullet.each()) {
-            if (bulletTransform.position.z < -40) {
-                if (!registry.any_of<DestroyTag>(bulletEntity)) {
-                    registry.emplace<DestroyTag>(bulletEntity);
-                }
+        for (const auto& bullet : lane.playerBullets) {
+            if (bullet.z < -40) {
                 continue;
             }
 
-            if (enemyTransform.position.z < bulletTransform.position.z) {
-                continue;
+            while (enemyIt != lane.enemies.end()
+                && (enemyIt->z < bullet.z || registry.get<Health>(enemyIt->entity).current <= 0)) {
+                ++enemyIt;
             }
 
-            if (enemyTransform.position.x != bulletTransform.position.x) {
-                continue;
+            if (enemyIt == lane.enemies.end()) {
+                break;
             }
 
+            Health& enemyHealth{ registry.get<Health>(enemyIt->entity) };
+            const Damage& bulletDamage{ registry.get<Damage>(bullet.entity) };
+
             enemyHealth.current -= bulletDamage.current;
 
-            if (!registry.any_of<DestroyTag>(bulletEntity)) {
-                registry.emplace<DestroyTag>(bulletEntity);
-            }
+            commands.destroy(bullet.entity);
 
             stats.damageDealt += bulletDamage.current;
 
             if (enemyHealth.current <= 0) {
-                if (!registry.any_of<DestroyTag>(enemyEntity)) {
-                    registry.emplace<DestroyTag>(enemyEntity);
-                }
+                commands.destroy(enemyIt->entity);
             }
         }
     }
@@ -169,37 +276,29 @@ void receivingDamageSystem(entt::registry& registry, const float deltaTime) {
         return;
     }
 
+    const auto playerLane{ Lane::getLaneFromXPosition(transform.position.x) };
+
     // Player recieving damage from enemys bullet.
-    for (auto [bulletEntity, bulletTransform, damage] : enemyBullet.each()) {
-        if (bulletTransform.position.z > 0) {
+    if (playerLane) {
+        const auto& lane{ collisionIndex.getLane(*playerLane) };
 
-            if (!registry.any_of<DestroyTag>(bulletEntity)) {
-                registry.emplace<DestroyTag>(bulletEntity);
+        for (const auto& bullet : CollisionIndex::fromZ(lane.enemyBullets, transform.position.z)) {
+            if (bullet.z > -6) {
+                break;
             }
-            continue;
-        }
-        if (bulletTransform.position.z > -6) {
-            continue;
-        }
 
-        if (bulletTransform.position.z <= transform.position.z) {
-            continue;
-        }
-
-        if (transform.position.x != bulletTransform.position.x) {
-            continue;
-        }
-
-        //std::cout << "bullet: " << bulletTransform.position.z << "\n";
+            if (bullet.z <= transform.position.z) {
+                continue;
+            }
 
-        health.current -= damage.current;
-        timeDelay.recievingDamageDelay = invincibilityTime;
+            const Damage& damage{ registry.get<Damage>(bullet.entity) };
 
-        stats.lostHealth += damage.current;
+            health.current -= damage.current;
+            timeDelay.recievingDamageDelay = invincibilityTime;
 
+            stats.lostHealth += damage.current;
 
-        if (!registry.any_of<DestroyTag>(bulletEntity)) {
-            registry.emplace<DestroyTag>(bulletEntity);
+            commands.destroy(bullet.entity);
         }
     }
 
@@ -207,36 +306,28 @@ void receivingDamageSystem(entt::registry& registry, const float deltaTime) {
         return;
     }
 
-    // Player recieving damage from enemy
-    for (auto [enemyEntity, enemyTransform, damage, enemyHealth] : enemy.each()) {
-        int additionalDmg{};
+    // Player recieving damage from enemy, enemies outside of players lane only hit once they get past him.
+    for (std::size_t laneIdx{}; laneIdx < Lane::laneCount; ++laneIdx) {
+        const auto& lane{ collisionIndex.getLane(static_cast<Lane::Lane>(laneIdx)) };
+        const bool isPlayerLane{ playerLane && static_cast<std::size_t>(*playerLane) == laneIdx };
 
-        if (transform.position.x != enemyTransform.position.x) {
-            if (enemyTransform.position.z < -2) {
-                continue;
-            }
-            additionalDmg = 20;
-        }
-
-        if (enemyTransform.position.z < transform.position.z) {
-            continue;
-        }
+        const int additionalDmg{ isPlayerLane ? 0 : 20 };
+        const float minZ{ isPlayerLane ? transform.position.z : std::max(transform.position.z, -2.f) };
 
-        //std::cout << enemyTransform.position.z << " " << transform.position.z << "\n";
+        for (const auto& enemy : CollisionIndex::fromZ(lane.enemies, minZ)) {
+            const Damage& damage{ registry.get<Damage>(enemy.entity) };
 
-        health.current -= damage.current + additionalDmg;
-        timeDelay.recievingDamageDelay = invincibilityTime;
+            health.current -= damage.current + additionalDmg;
+            timeDelay.recievingDamageDelay = invincibilityTime;
 
-        stats.lostHealth += damage.current + additionalDmg;
+            stats.lostHealth += damage.current + additionalDmg;
 
-
-        if (!registry.any_of<DestroyTag>(enemyEntity)) {
-            registry.emplace<DestroyTag>(enemyEntity);
+            commands.destroy(enemy.entity);
         }
     }
 }
 
-void enemyShootingSystem(entt::registry& registry, ModelStore& modelStore, const float deltaTime) {
+void enemyShootingSystem(entt::registry& registry, EntityCommandBuffer& commands, Xoshiro256& random, const float deltaTime) {
     auto enemy = registry.view<EnemyTag, TimeDelay, Transform>();
 
     for (auto [enemyEntity, timeDelay, transform] : enemy.each()) {
@@ -245,21 +336,14 @@ void enemyShootingSystem(entt::registry& registry, ModelStore& modelStore, const
             continue;
         }
 
-        timeDelay.shootingDelay = getRandomDelay(2.0f, 3.0f);
-
-        constexpr auto path{ "assets/3d-models/bullet.obj" };
-        glm::vec3 velocity{0.0f, 0.0f, 2.0f};
+        timeDelay.shootingDelay = getRandomDelay(random, 2.0f, 3.0f);
 
-        createBullet(registry, EntityTypes::Enemy, modelStore.load(path, 0.1f), transform.position, glm::vec3{90.0f, 0.0f, 0.0f}, velocity);
+        commands.spawnBullet(EntityTypes::Enemy, transform.position);
     }
 }
 
-float getRandomDelay(float min, float max) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
-    std::uniform_real_distribution<float> distrib(min, max);
-    float rawNumber = distrib(gen);
+float getRandomDelay(Xoshiro256& random, const float min, const float max) {
+    const float rawNumber{ random.uniform(min, max) };
 
     return std::round(rawNumber * 10) / 10.0f;
 }
\ No newline at end of file
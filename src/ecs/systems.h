@@ -4,18 +4,29 @@
 #define SYSTEMS_H
 
 #include "entities.h"
+#include "render-snapshot.h"
+
 class Renderer;
-class InputManager;
-class ModelStore;
-class AudioEngine;
+class InputState;
+class CollisionIndex;
+class BulletPool;
+class EntityCommandBuffer;
+class Xoshiro256;
 
 //Generel systems
 
 /**
- * @brief Updates entity positions based on their velocity.
+ * @brief Updates entity positions and rotations based on their velocity.
+ *
+ * Owns a group of Transform and Velocity, which keeps both storages packed
+ * in the same order, and integrates them page by page with the SIMD
+ * kernel of multiplyAdd(). Emplacing or removing either component swaps
+ * elements inside both storages, so no Transform reference may be held
+ * across such a change.
  *
- * Iterates over all entities that have Transform and Velocity components
- * and moves them according to the elapsed frame time.
+ * Both Velocity::linear and Velocity::angular are integrated with the same
+ * factor, deltaTime times a movement speed factor of 5, so one stored unit
+ * advances a Transform by 5 units (or degrees) per second.
  *
  * @param registry ECS registry containing all entities.
  * @param deltaTime Time elapsed since the last frame.
@@ -23,25 +34,64 @@ class AudioEngine;
 void movementSystem(entt::registry& registry, const float deltaTime);
 
 /**
- * @brief Renders all drawable entities.
+ * @brief Stores the current transforms for render interpolation.
+ *
+ * Copies every Transform into a PreviousTransform component.
+ * Should be called at the start of every simulation step.
+ *
+ * @param registry ECS registry containing all entities.
+ */
+void storePreviousTransformSystem(entt::registry& registry);
+
+/**
+ * @brief Updates the cached world matrices of all transforms.
+ *
+ * Adds a WorldTransform to entities created since the last step.
+ * The rotation is rebuilt only for entities whose rotation changed,
+ * otherwise only the translation is written.
+ * Should be called at the end of every simulation step.
+ *
+ * @param registry ECS registry containing all entities.
+ */
+void worldTransformSystem(entt::registry& registry);
+
+/**
+ * @brief Copies the drawable entities and the player state into a snapshot.
  *
- * Builds model matrices from Transform components and submits them
- * to the renderer using the associated Render component.
+ * Captures the cached WorldTransform matrices with the associated Render
+ * component, plus the PreviousTransform of entities that have one.
+ * Reuses the capacity of the snapshot, the current level and the
+ * interpolation factor are left to the caller.
  *
  * @param registry ECS registry containing all entities.
+ * @param snapshot Snapshot to overwrite.
+ */
+void snapshotSystem(const entt::registry& registry, RenderSnapshot& snapshot);
+
+/**
+ * @brief Renders all entities of a snapshot.
+ *
+ * Interpolated instances are drawn in between their previous and current
+ * position using the alpha of the snapshot, and only rebuild their
+ * rotation if it changed during the step.
+ *
+ * @param snapshot Snapshot captured by snapshotSystem().
  * @param renderer Renderer used to draw objects.
  */
-void renderingSystem(entt::registry& registry, Renderer& renderer);
+void renderingSystem(const RenderSnapshot& snapshot, Renderer& renderer);
 
 /**
- * @brief Destroys entities marked for removal.
+ * @brief Applies the structural changes the systems before it recorded during the step.
  *
- * Iterates over entities with the ShouldDestroy component and
- * removes them from the registry when flagged.
+ * Flushes the command buffer, destroying recorded entities in a single
+ * batch and then spawning the recorded bullets. Pooled bullets are
+ * returned to their pool instead of being destroyed.
  *
  * @param registry ECS registry containing all entities.
+ * @param commands Command buffer the other systems record into.
+ * @param bulletPool Pool releasing destroyed bullets and activating spawned ones.
  */
-void cleanUpSystem(entt::registry& registry);
+void cleanUpSystem(entt::registry& registry, EntityCommandBuffer& commands, BulletPool& bulletPool);
 
 //Player systems
 
@@ -49,15 +99,15 @@ void cleanUpSystem(entt::registry& registry);
  * @brief Handles player input, movement between lanes, and shooting.
  *
  * Processes keyboard input, updates player lane animations,
- * handles shooting cooldowns, and spawns player bullets.
+ * handles shooting cooldowns, and records player bullet spawns.
  *
  * @param registry ECS registry containing all entities.
- * @param inputManager Input handler providing current input state.
- * @param modelStore Storage used to load and access models.
- * @param audioEngine Audio engine for playing sound effects.
+ * @param inputState Current input state.
+ * @param commands Command buffer recording the bullet spawns.
  * @param deltaTime Time elapsed since the last frame.
+ * @return True if the player fired a bullet, so the caller can play sound effects.
  */
-void playerInputSystem(entt::registry& registry, const InputManager& inputManager, ModelStore& modelStore, AudioEngine& audioEngine, const float deltaTime);
+bool playerInputSystem(entt::registry& registry, const InputState& inputState, EntityCommandBuffer& commands, const float deltaTime);
 
 /**
  * @brief Restores player health to maximum.
@@ -74,25 +124,32 @@ void restorePlayerHealthSystem(entt::registry& registry);
  * @brief Processes damage received by player and enemies.
  *
  * Handles bullet collisions, enemy collisions, invincibility timing,
- * health reduction, and entity destruction.
+ * health reduction, and entity destruction. Hit entities are recorded
+ * for destruction, which cleanUpSystem() applies later in the step.
+ *
+ * Collisions are resolved through a per-lane index that is rebuilt on
+ * every call, so the cost grows linearly with the number of entities.
  *
  * @param registry ECS registry containing all entities.
+ * @param collisionIndex Index reused between ticks to avoid reallocations.
+ * @param commands Command buffer recording the destroyed entities.
  * @param deltaTime Time elapsed since the last frame.
  */
-void receivingDamageSystem(entt::registry& registry, const float deltaTime);
+void receivingDamageSystem(entt::registry& registry, CollisionIndex& collisionIndex, EntityCommandBuffer& commands, const float deltaTime);
 
 //Enemy systems
 
 /**
  * @brief Controls enemy shooting behavior.
  *
- * Uses a randomized delay to spawn enemy bullets aimed forward.
+ * Uses a randomized delay to record spawns of enemy bullets aimed forward.
  *
  * @param registry ECS registry containing all entities.
- * @param modelStore Storage used to load and access models.
+ * @param commands Command buffer recording the bullet spawns.
+ * @param random Stream drawing the shooting delays.
  * @param deltaTime Time elapsed since the last frame.
  */
-void enemyShootingSystem(entt::registry& registry, ModelStore& modelStore, const float deltaTime);
+void enemyShootingSystem(entt::registry& registry, EntityCommandBuffer& commands, Xoshiro256& random, const float deltaTime);
 
 //Helping functions
 
@@ -101,10 +158,11 @@ void enemyShootingSystem(entt::registry& registry, ModelStore& modelStore, const
  *
  * Returns a rounded floating point value within the given range.
  *
+ * @param random Stream the value is drawn from.
  * @param min Minimum delay value.
  * @param max Maximum delay value.
  * @return Random delay value rounded to one decimal place.
  */
-float getRandomDelay(float min, float max);
+float getRandomDelay(Xoshiro256& random, const float min, const float max);
 
 #endif // !SYSTEMS_H
@@ -1,6 +1,8 @@
 #include "game.h"
 
+#include <core/allocation-tracker.h>
 #include <core/gl-window.h>
+#include <core/profiler.h>
 
 #include <ui/main-menu.h>
 #include <ui/hud.h>
@@ -9,22 +11,66 @@
 #include <ui/victory-screen.h>
 
 #include <ecs/systems.h>
-#include <ecs/queries.h>
-
-#include "levels.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <utility>
 
 Game::Game(const GlWindow& window)
-        : m_inputManager{ window.getNativeHandle() } {
+        : m_inputManager{ window.getNativeHandle() }
+        , m_fixedTimestep{
+            1.0 / std::max(m_settings.tickRate, 1),
+            static_cast<std::size_t>(std::max(m_settings.maxTicksPerFrame, 1))
+        } {
+    m_simulation.getModelStore().setRetentionPolicy({
+        .cpuByteBudget{ static_cast<std::size_t>(std::max(m_settings.modelCpuBudgetMb, 0)) << 20 },
+        .gpuByteBudget{ static_cast<std::size_t>(std::max(m_settings.modelGpuBudgetMb, 0)) << 20 },
+    });
+
+    m_fpsCounter.setSessionLogging(m_settings.exportFrameTimes);
+
+    // The opt-in hitch detector attributes long frames to the recorded zones.
+    Profiler::setEnabled(m_settings.profilerEnabled || m_settings.hitchBudgetMs > 0.f);
+
     m_audioEngine.setVolume(m_settings.volume);
     m_audioEngine.playAmbient("assets/sounds/space-ambient.mp3");
+
+    m_simulationThread = std::thread{ [this] { runSimulation(); } };
+}
+
+Game::~Game() {
+    waitForSimulation();
+
+    m_isStopping = true;
+    m_isSimulationBusy.store(true, std::memory_order_release);
+    m_isSimulationBusy.notify_one();
+
+    m_simulationThread.join();
 }
 
 void Game::update(double dt) {
+    PROFILE_ZONE("Game::update");
     m_fpsCounter.update(dt);
     m_inputManager.update();
 
+    if (!m_isSimulationBusy.load(std::memory_order_acquire)) {
+        applyStepOutcome();
+
+        m_simulation.getModelStore().processUploads(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float, std::milli>{ m_settings.assetUploadBudgetMs }
+        ));
+    }
+
+    m_snapshots.acquire();
+
+    // Decided after the outcome is applied, so the switch to another state does not count.
+    m_playingFrameCount = m_gameState == GameState::Playing ? m_playingFrameCount + 1 : 0;
+    AllocationTracker::setAllocationsForbidden(
+        m_settings.forbidSteadyStateAllocations && m_playingFrameCount > allocationWarmUpFrames
+    );
+
     dt *= m_settings.gameSpeed;
 
     switch (m_gameState) {
@@ -36,7 +82,7 @@ void Game::update(double dt) {
         if (m_inputManager.isPressed(InputManager::Escape)) {
             m_gameState = GameState::Paused;
         }
-        updateSystems(dt);
+        scheduleSteps(dt);
         break;
     case GameState::Paused:
         ui::drawHud(*this, dt);
@@ -57,10 +103,11 @@ void Game::update(double dt) {
 }
 
 void Game::render(Renderer& renderer) {
+    PROFILE_ZONE("Game::render");
     switch (m_gameState) {
     case GameState::Playing:
     case GameState::Paused:
-        renderingSystem(m_registry, renderer);
+        renderingSystem(getSnapshot(), renderer);
         break;
     case GameState::MainMenu:
     case GameState::GameOver:
@@ -71,50 +118,99 @@ void Game::render(Renderer& renderer) {
 }
 
 void Game::loadPlayer() {
-    constexpr auto playerPath{ "assets/3d-models/Battle-SpaceShip-Free-3D-Low-Poly-Models/Destroyer_01.fbx" };
+    waitForSimulation();
 
-    m_enemyIdx = 0;
-    m_currentLevel = 0;
-    m_timePassed = 0;
+    m_stepOutcome = {};
+    m_pendingStepCount = 0;
 
-    m_registry.clear();
+    // Every run gets a fresh seed, Simulation::getSeed() allows replaying it.
+    m_simulation.reset(std::random_device{}());
 
-    createPlayer(m_registry, m_modelStore.load(playerPath, 0.0003f), glm::vec3{ 0.f, -2.f, -7.f });
+    // Publish the new run right away, so no frame shows the previous one.
+    RenderSnapshot& snapshot{ m_snapshots.getWriteBuffer() };
+    m_simulation.captureSnapshot(snapshot);
+    snapshot.alpha = 1.f;
+    m_snapshots.publish();
+    m_snapshots.acquire();
 }
 
-void Game::updateSystems(const double dt) {
+void Game::scheduleSteps(const double dt) {
+    m_pendingStepCount = std::min(m_pendingStepCount + m_fixedTimestep.advance(dt), m_fixedTimestep.getMaxStepsPerFrame());
 
-    if (!isPlayerAlive(m_registry)) {
-        m_gameState = GameState::GameOver;
+    if (m_isSimulationBusy.load(std::memory_order_acquire)) {
         return;
     }
 
-    m_timePassed += dt;
+    // Batches without steps still refresh the interpolation factor of the snapshot.
+    m_stepBatch = {
+        .input{ m_inputManager },
+        .stepCount{ std::exchange(m_pendingStepCount, 0) },
+        .stepSize{ m_fixedTimestep.getStepSize() },
+        .alpha{ static_cast<float>(m_fixedTimestep.getAlpha()) },
+    };
 
-    if (gameplay::levels.size() <= m_currentLevel) {
-        m_gameState = GameState::Victory;
-        return;
+    m_isSimulationBusy.store(true, std::memory_order_release);
+    m_isSimulationBusy.notify_one();
+}
+
+void Game::applyStepOutcome() {
+    const StepOutcome outcome{ std::exchange(m_stepOutcome, {}) };
+
+    if (outcome.error) {
+        std::rethrow_exception(outcome.error);
     }
 
-    if (gameplay::levels[m_currentLevel].spawns.size() <= m_enemyIdx) {
-        if (m_currentLevel < gameplay::levels.size() && !enemyExists(m_registry)) {
-            ++m_currentLevel;
-            m_enemyIdx = 0;
-            m_timePassed = 0;
-            restorePlayerHealthSystem(m_registry);
-        }
+    for (std::size_t i{}; i < outcome.firedCount; ++i) {
+        m_audioEngine.play("assets/sounds/space-laser.mp3");
     }
-    else if (gameplay::levels[m_currentLevel].spawns[m_enemyIdx].spawnTime < m_timePassed * 1000) {
-        auto enemyType{ gameplay::levels[m_currentLevel].spawns[m_enemyIdx].enemyType };
-        auto lane{ gameplay::levels[m_currentLevel].spawns[m_enemyIdx].lane };
-        createEntity(m_registry, enemyType, m_modelStore, lane);
-        ++m_enemyIdx;
+
+    switch (outcome.status) {
+    case SimulationStatus::PlayerDied:
+        m_gameState = GameState::GameOver;
+        break;
+    case SimulationStatus::LevelsCleared:
+        m_gameState = GameState::Victory;
+        break;
+    case SimulationStatus::Running:
+    default:
+        break;
     }
+}
 
-    cleanUpSystem(m_registry);
-    enemyShootingSystem(m_registry, m_modelStore, dt);
-    receivingDamageSystem(m_registry, dt);
-    playerInputSystem(m_registry, m_inputManager, m_modelStore, m_audioEngine, dt);
-    movementSystem(m_registry, dt);
+void Game::waitForSimulation() noexcept {
+    m_isSimulationBusy.wait(true, std::memory_order_acquire);
 }
 
+void Game::runSimulation() {
+    Profiler::setThreadName("Simulation");
+
+    while (true) {
+        m_isSimulationBusy.wait(false, std::memory_order_acquire);
+        if (m_isStopping) {
+            return;
+        }
+
+        PROFILE_ZONE("Game::runSimulation batch");
+        try {
+            for (std::size_t i{}; i < m_stepBatch.stepCount; ++i) {
+                const StepResult result{ m_simulation.update(m_stepBatch.input, m_stepBatch.stepSize) };
+                m_stepOutcome.firedCount += result.playerFired;
+
+                if (result.status != SimulationStatus::Running) {
+                    m_stepOutcome.status = result.status;
+                    break;
+                }
+            }
+
+            RenderSnapshot& snapshot{ m_snapshots.getWriteBuffer() };
+            m_simulation.captureSnapshot(snapshot);
+            snapshot.alpha = m_stepBatch.alpha;
+            m_snapshots.publish();
+        } catch (...) {
+            m_stepOutcome.error = std::current_exception();
+        }
+
+        m_isSimulationBusy.store(false, std::memory_order_release);
+        m_isSimulationBusy.notify_all();
+    }
+}
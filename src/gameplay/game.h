@@ -4,17 +4,29 @@
 #define GAME_H
 
 #include <core/audio-engine.h>
+#include <core/fixed-timestep.h>
 #include <core/fps-counter.h>
 #include <core/input-manager.h>
+#include <core/input-state.h>
 #include <core/settings.h>
 #include <core/timer.h>
+#include <core/triple-buffer.h>
 
 #include <renderer/camera.h>
-#include <renderer/model-store.h>
+#include <renderer/gpu-timer.h>
 #include <renderer/lighting.h>
 
+#include <ecs/render-snapshot.h>
+
 #include <entt/entity/registry.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+
+#include "simulation.h"
+
 class Renderer;
 class GlWindow;
 
@@ -31,6 +43,14 @@ enum class GameState {
  *
  * Owns and coordinates all major game subsystems, including input,
  * rendering, audio, and entity management.
+ *
+ * The simulation runs on its own thread. Every frame the OpenGL thread
+ * hands it a batch of fixed steps and goes on drawing the latest
+ * RenderSnapshot, while the batch runs and publishes the next one through
+ * a TripleBuffer. The Simulation and its ModelStore belong to the
+ * simulation thread while a batch runs, the OpenGL thread only touches
+ * them, for uploads and restarts, while it is idle. The renderer only
+ * reads resources, which the simulation thread never modifies.
  */
 class Game {
 public:
@@ -49,11 +69,22 @@ public:
     Game(Game&&) = delete;
     Game& operator=(Game&&) = delete;
 
+    /**
+     * @brief Waits for the running batch and joins the simulation thread.
+     */
+    ~Game();
+
     /**
      * @brief Updates the game state.
      *
-     * Advances simulation, processes input, and updates entities.
-     * Should be called once per frame.
+     * Processes input, applies the outcome of the previous batch of steps,
+     * uploads asynchronously loaded models, draws the UI and hands the
+     * simulation thread the fixed steps due this frame, independently of
+     * the frame rate. Never waits for the simulation thread, if it is still
+     * busy the steps are handed over in a later frame.
+     * Should be called once per frame on the OpenGL context thread.
+     *
+     * @throws std::runtime_error If a simulation step failed.
      *
      * @param dt Time delta in seconds since the last update.
      */
@@ -62,7 +93,8 @@ public:
     /**
      * @brief Renders the current game state.
      *
-     * Should be called once per frame.
+     * Draws the latest snapshot, with entity transforms interpolated
+     * between its two steps. Should be called once per frame.
      *
      * @param renderer Renderer used to draw the scene.
      */
@@ -74,20 +106,30 @@ public:
     void requestQuit() noexcept { m_shouldQuit = true; }
 
     /**
-     * @brief Initializes the player entity and lears the current registry.
+     * @brief Initializes the player entity and clears the current registry.
+     *
+     * Waits for the running batch of steps, if any.
      *
      * @throws std::runtime_error If the player model fails to load.
      */
     void loadPlayer();
 
     [[nodiscard]] double getFps() const noexcept { return m_fpsCounter.getFps(); }
+    [[nodiscard]] const FpsCounter& getFpsCounter() const noexcept { return m_fpsCounter; }
+    [[nodiscard]] const GpuFrameTimings& getGpuTimings() const noexcept { return m_gpuTimings; }
+
+    /**
+     * @brief Stores the renderer's GPU times to be shown next to the CPU frame time.
+     */
+    void setGpuTimings(const GpuFrameTimings& timings) noexcept { m_gpuTimings = timings; }
     [[nodiscard]] const Settings& getSettings() const noexcept { return m_settings; }
     [[nodiscard]] Settings& getSettings() noexcept { return m_settings; }
     [[nodiscard]] const Camera& getCamera() const noexcept { return m_camera; }
     [[nodiscard]] Camera& getCamera() noexcept { return m_camera; }
     [[nodiscard]] const Lighting& getLighting() const noexcept { return m_lighting; }
-    [[nodiscard]] std::size_t getCurrentLevel() const noexcept { return m_currentLevel; }
-    [[nodiscard]] const entt::registry& getRegistry() const noexcept { return m_registry; }
+    [[nodiscard]] const ResourceRegistry& getResources() const noexcept { return m_simulation.getModelStore().getResources(); }
+    [[nodiscard]] std::size_t getCurrentLevel() const noexcept { return getSnapshot().currentLevel; }
+    [[nodiscard]] const RenderSnapshot& getSnapshot() const noexcept { return m_snapshots.getReadBuffer(); }
     [[nodiscard]] AudioEngine& getAudioEngine() noexcept { return m_audioEngine; }
     [[nodiscard]] bool shouldQuit() const noexcept { return m_shouldQuit; }
 
@@ -95,20 +137,57 @@ public:
     [[nodiscard]] GameState getState() const noexcept { return m_gameState; }
 
 private:
-    void updateSystems(const double dt);
+    /**
+     * @brief Steps handed to the simulation thread, written while it is idle.
+     */
+    struct StepBatch {
+        InputState input{};
+        std::size_t stepCount{};
+        double stepSize{};
+        float alpha{};
+    };
+
+    /**
+     * @brief Accumulated outcome of the batches since it was last applied.
+     */
+    struct StepOutcome {
+        SimulationStatus status{ SimulationStatus::Running };
+        std::size_t firedCount{};
+        std::exception_ptr error{};
+    };
+
+    /**
+     * @brief Accumulates the steps due and hands them over if the simulation thread is idle.
+     */
+    void scheduleSteps(const double dt);
+
+    /**
+     * @brief Plays sounds and switches the state for the outcome of finished batches.
+     *
+     * @throws std::runtime_error If a simulation step failed.
+     */
+    void applyStepOutcome();
 
-    double m_timePassed{};
-    std::size_t m_enemyIdx{};
-    std::size_t m_currentLevel{};
+    void waitForSimulation() noexcept;
+    void runSimulation();
+
+    /**
+     * @brief Frames of play after which allocations count as steady-state ones.
+     *
+     * Covers the model loads and pool growth at the start of a level.
+     */
+    static constexpr std::size_t allocationWarmUpFrames{ 300 };
 
     InputManager m_inputManager;
 
     AudioEngine m_audioEngine{};
     FpsCounter m_fpsCounter{};
+    GpuFrameTimings m_gpuTimings{};
+    std::size_t m_playingFrameCount{};
     Settings m_settings{ "config.json" };
+    FixedTimestep m_fixedTimestep;
 
     Camera m_camera{};
-    ModelStore m_modelStore{};
     Lighting m_lighting{
         .sunPosition{ 0.f, 20.f, 0.f },
         .sunColor{ 1.f, 1.f, 3.f },
@@ -118,7 +197,17 @@ private:
 
     bool m_shouldQuit{};
 
-    entt::registry m_registry{};
+    Simulation m_simulation{};
+
+    TripleBuffer<RenderSnapshot> m_snapshots{};
+    StepBatch m_stepBatch{};
+    StepOutcome m_stepOutcome{};
+    std::size_t m_pendingStepCount{};
+
+    /// Set by the OpenGL thread to hand over a batch, cleared by the simulation thread when done.
+    std::atomic<bool> m_isSimulationBusy{};
+    std::atomic<bool> m_isStopping{};
+    std::thread m_simulationThread{};
 };
 
 #endif // GAME_H
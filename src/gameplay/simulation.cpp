@@ -0,0 +1,135 @@
+#include "simulation.h"
+
+#include <core/input-state.h>
+#include <core/profiler.h>
+
+#include <ecs/systems.h>
+#include <ecs/queries.h>
+
+#include "levels.h"
+
+#include <string_view>
+
+/// Random stream names, changing one changes the runs recorded with it.
+namespace RandomStream {
+    inline constexpr std::string_view enemyFire{ "enemy-fire" };
+}
+
+static void retainRenderModel(ModelStore& modelStore, entt::registry& registry, const entt::entity entity) {
+    modelStore.addReference(registry.get<Render>(entity).object);
+}
+
+static void releaseRenderModel(ModelStore& modelStore, entt::registry& registry, const entt::entity entity) {
+    modelStore.removeReference(registry.get<Render>(entity).object);
+}
+
+Simulation::Simulation(const bool loadGeometry)
+        : m_modelStore{ m_jobSystem, loadGeometry } {
+    m_registry.on_construct<Render>().connect<&retainRenderModel>(m_modelStore);
+    m_registry.on_destroy<Render>().connect<&releaseRenderModel>(m_modelStore);
+
+    registerSystems();
+}
+
+void Simulation::registerSystems() {
+    // Bullet spawns are recorded into the command buffer and applied in recording order,
+    // which decides the pooled entities they reuse, so spawning systems are ordered through it.
+    // Destructions only come from receivingDamage and need no declared access.
+    const auto bulletSpawning{ [] {
+        return SystemAccess{}.writeResource<EntityCommandBuffer>();
+    } };
+
+    m_scheduler.add("storePreviousTransform",
+        SystemAccess{}.read<Transform>().write<PreviousTransform>(),
+        [this] { storePreviousTransformSystem(m_registry); });
+
+    m_scheduler.add("enemyShooting",
+        bulletSpawning().read<EnemyTag, Transform>().write<TimeDelay>().writeResource<RandomStreams>(),
+        [this] { enemyShootingSystem(m_registry, m_commands, m_random.getStream(RandomStream::enemyFire), m_stepDt); });
+
+    m_scheduler.add("receivingDamage",
+        SystemAccess{}
+            .read<PlayerTag, EnemyTag, PlayerBulletTag, EnemyBulletTag, Transform, Damage>()
+            .write<Health, TimeDelay, Stats>()
+            .writeResource<CollisionIndex>(),
+        [this] { receivingDamageSystem(m_registry, m_collisionIndex, m_commands, m_stepDt); });
+
+    m_scheduler.add("playerInput",
+        bulletSpawning().read<PlayerTag>().write<Transform, Animation, TimeDelay, Stats>().readResource<InputState>(),
+        [this] { m_stepResult.playerFired = playerInputSystem(m_registry, *m_stepInput, m_commands, m_stepDt); });
+
+    // The single sync point of a step, after every recording system and before
+    // movement, so spawned bullets move in the step they were fired.
+    m_scheduler.add("cleanUp",
+        SystemAccess{}.exclusive(),
+        [this] { cleanUpSystem(m_registry, m_commands, m_bulletPool); });
+
+    // Owning the Transform and Velocity group reorders both storages whenever an entity
+    // gains or loses either component, so no Transform reference may be held across
+    // an emplace or removal of Transform or Velocity.
+    m_scheduler.add("movement",
+        SystemAccess{}.write<Transform, Velocity>(),
+        [this] { movementSystem(m_registry, m_stepDt); });
+
+    m_scheduler.add("worldTransform",
+        SystemAccess{}.read<Transform>().write<WorldTransform>(),
+        [this] { worldTransformSystem(m_registry); });
+}
+
+void Simulation::reset(const std::uint64_t seed) {
+    m_enemyIdx = 0;
+    m_currentLevel = 0;
+    m_timePassed = 0;
+
+    m_random.reseed(seed);
+
+    m_registry.clear();
+    m_commands.clear();
+
+    pinEntityModels(m_modelStore);
+    m_prefabs = resolvePrefabs(m_modelStore);
+    m_bulletPool.reset(m_registry, m_prefabs.playerBullet, m_prefabs.enemyBullet);
+
+    createPlayer(m_registry, m_modelStore.load(EntityModels::player, EntityModels::shipScale), glm::vec3{ 0.f, -2.f, -7.f });
+}
+
+StepResult Simulation::update(const InputState& inputState, const double dt) {
+    PROFILE_ZONE("Simulation::update");
+    if (!isPlayerAlive(m_registry)) {
+        return { .status = SimulationStatus::PlayerDied };
+    }
+
+    m_timePassed += dt;
+
+    if (gameplay::levels.size() <= m_currentLevel) {
+        return { .status = SimulationStatus::LevelsCleared };
+    }
+
+    if (gameplay::levels[m_currentLevel].spawns.size() <= m_enemyIdx) {
+        if (m_currentLevel < gameplay::levels.size() && !enemyExists(m_registry)) {
+            ++m_currentLevel;
+            m_enemyIdx = 0;
+            m_timePassed = 0;
+            restorePlayerHealthSystem(m_registry);
+        }
+    }
+    else if (gameplay::levels[m_currentLevel].spawns[m_enemyIdx].spawnTime < m_timePassed * 1000) {
+        auto enemyType{ gameplay::levels[m_currentLevel].spawns[m_enemyIdx].enemyType };
+        auto lane{ gameplay::levels[m_currentLevel].spawns[m_enemyIdx].lane };
+        createEntity(m_registry, m_prefabs.getEnemy(enemyType), lane);
+        ++m_enemyIdx;
+    }
+
+    m_stepInput = &inputState;
+    m_stepDt = static_cast<float>(dt);
+    m_stepResult = {};
+
+    m_scheduler.run(m_registry, m_jobSystem);
+
+    return m_stepResult;
+}
+
+void Simulation::captureSnapshot(RenderSnapshot& snapshot) const {
+    snapshotSystem(m_registry, snapshot);
+    snapshot.currentLevel = m_currentLevel;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <core/random.h>
+#include <core/job-system.h>
+
+#include <renderer/model-store.h>
+
+#include <ecs/bullet-pool.h>
+#include <ecs/collision-index.h>
+#include <ecs/command-buffer.h>
+#include <ecs/entities.h>
+#include <ecs/render-snapshot.h>
+#include <ecs/system-scheduler.h>
+
+#include <entt/entity/registry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+class InputState;
+
+/**
+ * @brief State of the simulation after a step.
+ */
+enum class SimulationStatus {
+    Running,      ///< The level timeline is still in progress
+    PlayerDied,   ///< The player has run out of health
+    LevelsCleared ///< Every level has been completed
+};
+
+/**
+ * @brief Outcome of a single simulation step.
+ */
+struct StepResult {
+    SimulationStatus status{ SimulationStatus::Running };
+    bool playerFired{}; ///< The player fired a bullet during the step
+};
+
+/**
+ * @brief Gameplay simulation independent of any window, audio or UI.
+ *
+ * Owns the ECS registry and advances the systems along the
+ * gameplay::levels timeline using injected input. It does not touch
+ * GLFW, ImGui or the audio device, and when constructed without geometry
+ * loading it does not need an OpenGL context either.
+ *
+ * Every Render component holds a reference to its model in the
+ * ModelStore, so geometry drawn by live entities is never evicted.
+ *
+ * All randomness comes from RandomStreams seeded in reset(), so a run
+ * is reproduced bit for bit by its seed and input.
+ *
+ * The per-step systems run through a SystemScheduler, concurrently
+ * where their declared component access allows it.
+ */
+class Simulation {
+public:
+    /**
+     * @brief Constructs an empty simulation.
+     *
+     * @param loadGeometry Whether models should be loaded onto the GPU,
+     *        see ModelStore::ModelStore(bool).
+     */
+    explicit Simulation(const bool loadGeometry = true);
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    Simulation(Simulation&&) = delete;
+    Simulation& operator=(Simulation&&) = delete;
+
+    /**
+     * @brief Clears the registry, rewinds the level timeline and spawns the player.
+     *
+     * Also resolves the entity prefabs, refills the bullet pool
+     * and restarts the random streams.
+     *
+     * @param seed Seed of the run, see getSeed().
+     *
+     * @throws std::runtime_error If the player or bullet model fails to load.
+     */
+    void reset(const std::uint64_t seed);
+
+    /**
+     * @brief Advances the simulation by a single step.
+     *
+     * @param inputState Player input for this step.
+     * @param dt Time delta in seconds, already scaled by the game speed.
+     * @return Outcome of the step.
+     */
+    StepResult update(const InputState& inputState, const double dt);
+
+    /**
+     * @brief Copies what a frame needs to draw the current state into a snapshot.
+     *
+     * @param snapshot Snapshot to overwrite, its alpha is left unchanged.
+     */
+    void captureSnapshot(RenderSnapshot& snapshot) const;
+
+    [[nodiscard]] std::size_t getCurrentLevel() const noexcept { return m_currentLevel; }
+
+    /**
+     * @brief Returns the seed of the current run, recorded for replays.
+     */
+    [[nodiscard]] std::uint64_t getSeed() const noexcept { return m_random.getSeed(); }
+    [[nodiscard]] const entt::registry& getRegistry() const noexcept { return m_registry; }
+    [[nodiscard]] entt::registry& getRegistry() noexcept { return m_registry; }
+    [[nodiscard]] JobSystem& getJobSystem() noexcept { return m_jobSystem; }
+    [[nodiscard]] const ModelStore& getModelStore() const noexcept { return m_modelStore; }
+    [[nodiscard]] ModelStore& getModelStore() noexcept { return m_modelStore; }
+
+private:
+    /**
+     * @brief Registers the per-step systems with their component access, in serial order.
+     */
+    void registerSystems();
+
+    double m_timePassed{};
+    std::size_t m_enemyIdx{};
+    std::size_t m_currentLevel{};
+
+    JobSystem m_jobSystem{};
+    ModelStore m_modelStore;
+    Prefabs m_prefabs{};
+    BulletPool m_bulletPool{};
+    CollisionIndex m_collisionIndex{};
+    EntityCommandBuffer m_commands{};
+    RandomStreams m_random{};
+    entt::registry m_registry{};
+
+    SystemScheduler m_scheduler{};
+
+    // Inputs and outputs of the step being run by the scheduler.
+    const InputState* m_stepInput{};
+    float m_stepDt{};
+    StepResult m_stepResult{};
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,95 @@
+#include <core/input-state.h>
+
+#include <gameplay/simulation.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Scripted player input.
+ *
+ * Keeps firing and sweeps across the lanes, changing direction
+ * every couple of seconds of simulated time.
+ */
+[[nodiscard]] static InputState::KeyStates scriptedInput(const std::size_t frame, const double dt) {
+    const auto framesPerPhase{ static_cast<std::size_t>(2.0 / dt) + 1 };
+    const bool movesLeft{ (frame / framesPerPhase) % 2 == 0 };
+
+    InputState::KeyStates keyStates{};
+    keyStates[InputState::Key::A] = movesLeft;
+    keyStates[InputState::Key::D] = !movesLeft;
+    keyStates[InputState::Key::Space] = true;
+    return keyStates;
+}
+
+static int runHeadless(const std::size_t frameCount, const double dt, const std::uint64_t seed) {
+    Simulation simulation{ false };
+    InputState inputState{};
+
+    std::size_t playerDeaths{};
+    std::size_t clearedRuns{};
+    std::size_t firedBullets{};
+
+    // Consecutive runs use consecutive seeds, so the whole session is reproducible.
+    std::uint64_t runSeed{ seed };
+    simulation.reset(runSeed);
+
+    const auto startTime{ std::chrono::steady_clock::now() };
+
+    for (std::size_t frame{}; frame < frameCount; ++frame) {
+        inputState.setKeyStates(scriptedInput(frame, dt));
+
+        const StepResult result{ simulation.update(inputState, dt) };
+        firedBullets += result.playerFired;
+
+        switch (result.status) {
+        case SimulationStatus::PlayerDied:
+            ++playerDeaths;
+            simulation.reset(++runSeed);
+            break;
+        case SimulationStatus::LevelsCleared:
+            ++clearedRuns;
+            simulation.reset(++runSeed);
+            break;
+        case SimulationStatus::Running:
+        default:
+            break;
+        }
+    }
+
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - startTime };
+
+    std::cout << std::format("Seed: {}\n", seed);
+    std::cout << std::format("Simulated {} frames ({:.1f} s of game time) in {:.3f} s\n",
+        frameCount, frameCount * dt, elapsed.count());
+    std::cout << std::format("{:.0f} frames per second\n", frameCount / elapsed.count());
+    std::cout << std::format("Player deaths: {}, cleared runs: {}, fired bullets: {}, last level: {}\n",
+        playerDeaths, clearedRuns, firedBullets, simulation.getCurrentLevel() + 1);
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    int returnValue{ -1 };
+    try {
+        const std::size_t frameCount{ argc > 1 ? std::stoul(argv[1]) : 100'000 };
+        const double dt{ argc > 2 ? std::stod(argv[2]) : 1.0 / 60.0 };
+        const std::uint64_t seed{ argc > 3 ? std::stoull(argv[3]) : 1 };
+        if (dt <= 0.0) {
+            throw std::invalid_argument{ "Time step has to be positive" };
+        }
+
+        returnValue = runHeadless(frameCount, dt, seed);
+    } catch (const std::exception& exception) {
+        std::cerr << std::format("Fatal error: {}\n", exception.what());
+    } catch (...) {
+        std::cerr << "Unknown fatal error\n";
+    }
+
+    return returnValue;
+}
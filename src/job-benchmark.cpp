@@ -0,0 +1,80 @@
+#include <core/job-system.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+/// Jobs per measurement, enough to amortize the final wait.
+static constexpr std::size_t jobCount{ 1'000'000 };
+
+/// Measurements per scenario, the fastest one is reported.
+static constexpr int repetitions{ 5 };
+
+/**
+ * @brief Runs a scenario repeatedly and prints the best time per job.
+ */
+template <typename Function>
+static void measure(const std::string_view name, Function&& function) {
+    double bestSeconds{ 1e30 };
+
+    for (int i{}; i < repetitions; ++i) {
+        const auto startTime{ std::chrono::steady_clock::now() };
+        function();
+        const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - startTime };
+
+        if (elapsed.count() < bestSeconds) {
+            bestSeconds = elapsed.count();
+        }
+    }
+
+    std::cout << std::format("{:<28} {:>8.1f} ns/job\n", name, bestSeconds * 1e9 / static_cast<double>(jobCount));
+}
+
+int main() {
+    JobSystem jobSystem{};
+    std::cout << std::format("Worker threads: {}\n", jobSystem.getThreadCount());
+
+    std::atomic<std::size_t> counter{};
+    const auto increment{ [&counter] { counter.fetch_add(1, std::memory_order_relaxed); } };
+    const auto waitForAll{ [&] {
+        jobSystem.helpUntil([&counter] { return counter.load() == jobCount; });
+        counter = 0;
+    } };
+
+    // Every job goes through the shared injection queue.
+    measure("external schedule + wait", [&] {
+        for (std::size_t i{}; i < jobCount; ++i) {
+            jobSystem.schedule(increment);
+        }
+        waitForAll();
+    });
+
+    // Jobs land in the deque of the worker scheduling them and get stolen from there.
+    measure("schedule from a worker", [&] {
+        jobSystem.schedule([&] {
+            for (std::size_t i{}; i < jobCount; ++i) {
+                jobSystem.schedule(increment);
+            }
+        });
+        waitForAll();
+    });
+
+    // Every job only becomes runnable once its predecessor finished.
+    measure("continuation chain", [&] {
+        JobHandle last{ jobSystem.schedule(increment) };
+        for (std::size_t i{ 1 }; i < jobCount; ++i) {
+            last = jobSystem.then(last, increment);
+        }
+        waitForAll();
+    });
+
+    measure("parallelFor, 1 per chunk", [&] {
+        jobSystem.parallelFor(jobCount, 1, [&](const std::size_t, const std::size_t) { increment(); });
+        waitForAll();
+    });
+
+    return 0;
+}
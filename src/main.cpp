@@ -1,4 +1,7 @@
+#include <core/allocation-tracker.h>
 #include <core/gl-window.h>
+#include <core/hitch-detector.h>
+#include <core/profiler.h>
 #include <gameplay/game.h>
 #include <ui/ui-core.h>
 #include <renderer/renderer.h>
@@ -6,8 +9,10 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <array>
 #include <format>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 
 static int runGame() {
@@ -23,23 +28,68 @@ static int runGame() {
     Renderer renderer{};
     Timer timer{};
 
+    Profiler::setThreadName("Main");
+
+    std::optional<HitchDetector> hitchDetector{};
+    if (game.getSettings().hitchBudgetMs > 0.f) {
+        hitchDetector.emplace("hitches.log", game.getSettings().hitchBudgetMs);
+    }
+
     while (!window.shouldClose() && !game.shouldQuit()) {
+        if (hitchDetector) {
+            hitchDetector->markFrame();
+        }
+        AllocationTracker::markFrame();
+
+        PROFILE_ZONE("Frame");
         timer.update();
 
         window.pollEvents();
 
         ui::beginFrame();
-        renderer.beginFrame(game.getLighting(), game.getCamera());
+        renderer.beginFrame(game.getLighting(), game.getCamera(), game.getResources());
 
+        game.setGpuTimings(renderer.getGpuTimings());
         game.update(timer.getDt<double>());
         game.render(renderer);
 
         renderer.endFrame();
+
+        renderer.beginUiPass();
         ui::endFrame();
+        renderer.endUiPass();
 
+        PROFILE_ZONE("GlWindow::swapBuffers");
         window.swapBuffers();
     }
 
+    if (game.getSettings().profilerEnabled) {
+        constexpr auto tracePath{ "profile-trace.json" };
+        Profiler::writeChromeTrace(tracePath);
+        std::cout << std::format("Profile trace written to {}\n", tracePath);
+    }
+
+    if (game.getSettings().exportFrameTimes) {
+        constexpr auto frameTimesPath{ "frame-times.csv" };
+        game.getFpsCounter().writeCsv(frameTimesPath);
+        std::cout << std::format("Frame times written to {}\n", frameTimesPath);
+    }
+
+    if (const AllocationCounts violations{ AllocationTracker::getViolationCounts() }; violations.count > 0) {
+        std::array<AllocationTracker::ZoneCounts, AllocationTracker::maxZoneCount> zones{};
+        const std::size_t zoneCount{ AllocationTracker::copyViolations(zones) };
+
+        std::cerr << std::format("{} forbidden allocations, {} bytes, during steady-state play:\n", violations.count, violations.bytes);
+        for (std::size_t i{}; i < zoneCount; ++i) {
+            std::cerr << std::format("  {}: {} allocations, {} bytes\n",
+                zones[i].name ? zones[i].name : "No zone", zones[i].counts.count, zones[i].counts.bytes);
+        }
+
+        if (const AllocationCounts dropped{ AllocationTracker::getDroppedViolationCounts() }; dropped.count > 0) {
+            std::cerr << std::format("  Zones beyond the table: {} allocations, {} bytes\n", dropped.count, dropped.bytes);
+        }
+    }
+
     return 0;
 }
 
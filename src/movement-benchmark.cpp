@@ -0,0 +1,90 @@
+#include <core/batch-math.h>
+
+#include <ecs/components.h>
+#include <ecs/systems.h>
+
+#include <entt/entity/registry.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <vector>
+
+/// Entity counts the throughput is measured at.
+static constexpr std::array entityCounts{ std::size_t{ 10'000 }, std::size_t{ 100'000 }, std::size_t{ 1'000'000 } };
+
+/// Entity updates per measurement, so small counts are repeated enough to time reliably.
+static constexpr std::size_t updatesPerMeasurement{ 100'000'000 };
+
+static constexpr float dt{ 1.f / 60.f };
+
+/**
+ * @brief Runs a function repeatedly and returns the entity updates per second.
+ */
+template <typename Function>
+[[nodiscard]] static double measureThroughput(const std::size_t entityCount, Function&& function) {
+    const std::size_t iterations{ updatesPerMeasurement / entityCount };
+
+    const auto startTime{ std::chrono::steady_clock::now() };
+    for (std::size_t i{}; i < iterations; ++i) {
+        function();
+    }
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - startTime };
+
+    return static_cast<double>(iterations * entityCount) / elapsed.count();
+}
+
+/**
+ * @brief Measures the bare kernel over arrays shaped like the Transform and Velocity storages.
+ */
+static void benchmarkKernel(const std::size_t entityCount, const SimdLevel level) {
+    constexpr std::size_t floatsPerEntity{ sizeof(Transform) / sizeof(float) };
+
+    std::vector<float> values(entityCount * floatsPerEntity, 0.f);
+    const std::vector<float> deltas(entityCount * floatsPerEntity, 1.f);
+
+    const double throughput{ measureThroughput(entityCount, [&] {
+        multiplyAdd(level, values, deltas, dt);
+    }) };
+
+    std::cout << std::format("{:>9} entities  kernel {:<8} {:>8.1f} M entities/s\n",
+        entityCount, getSimdLevelName(level), throughput / 1e6);
+}
+
+/**
+ * @brief Measures movementSystem() on a registry where every entity moves.
+ */
+static void benchmarkSystem(const std::size_t entityCount) {
+    entt::registry registry{};
+
+    for (std::size_t i{}; i < entityCount; ++i) {
+        const entt::entity entity{ registry.create() };
+        registry.emplace<Transform>(entity, glm::vec3{ static_cast<float>(i), 0.f, 0.f });
+        registry.emplace<Velocity>(entity, glm::vec3{ 0.f, 0.f, 1.f });
+    }
+
+    const double throughput{ measureThroughput(entityCount, [&] {
+        movementSystem(registry, dt);
+    }) };
+
+    std::cout << std::format("{:>9} entities  movementSystem  {:>8.1f} M entities/s\n",
+        entityCount, throughput / 1e6);
+}
+
+int main() {
+    const SimdLevel supportedLevel{ getSimdLevel() };
+    std::cout << std::format("Detected instruction set: {}\n", getSimdLevelName(supportedLevel));
+
+    for (const std::size_t entityCount : entityCounts) {
+        for (const SimdLevel level : { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 }) {
+            if (level <= supportedLevel) {
+                benchmarkKernel(entityCount, level);
+            }
+        }
+        benchmarkSystem(entityCount);
+    }
+
+    return 0;
+}
@@ -34,6 +34,7 @@ public:
     [[nodiscard]] float getPitch() const noexcept { return m_pitch; }
     [[nodiscard]] float getRoll() const noexcept { return m_roll; }
     [[nodiscard]] float getAspectRatio() const noexcept { return m_aspectRatio; }
+    [[nodiscard]] float getFarPlane() const noexcept { return m_farPlane; }
 
     /**
      * @brief Returns the cached view matrix, recalculates it if the dirty flag is set.
@@ -0,0 +1,53 @@
+#include "gpu-timer.h"
+
+#include "gl-call.h"
+
+GpuTimer::GpuTimer() {
+    GL_CALL(glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data()));
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+}
+
+void GpuTimer::begin() noexcept {
+    readBackResults();
+
+    if (m_pendingCount == m_queries.size()) {
+        return;
+    }
+
+    const std::size_t next{ (m_oldestPending + m_pendingCount) % m_queries.size() };
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[next]);
+    m_isActive = true;
+}
+
+void GpuTimer::end() noexcept {
+    if (!m_isActive) {
+        return;
+    }
+
+    glEndQuery(GL_TIME_ELAPSED);
+    m_isActive = false;
+    ++m_pendingCount;
+}
+
+void GpuTimer::readBackResults() noexcept {
+    // Queries finish in submission order, so the first unavailable one ends the read back.
+    while (m_pendingCount > 0) {
+        const GLuint query{ m_queries[m_oldestPending] };
+
+        GLint isAvailable{};
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (!isAvailable) {
+            return;
+        }
+
+        GLuint64 elapsedNs{};
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+        m_elapsedMs = static_cast<double>(elapsedNs) / 1e6;
+
+        m_oldestPending = (m_oldestPending + 1) % m_queries.size();
+        --m_pendingCount;
+    }
+}
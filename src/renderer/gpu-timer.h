@@ -0,0 +1,81 @@
+#pragma once
+
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief GPU times of the latest measured frame in milliseconds.
+ */
+struct GpuFrameTimings {
+    double sceneMs{}; ///< Time of the scene pass, from Renderer::beginFrame() to Renderer::endFrame()
+    double uiMs{};    ///< Time of the UI pass
+};
+
+/**
+ * @brief Measures the GPU time of a pass with GL_TIME_ELAPSED queries.
+ *
+ * Every begin() and end() pair issues a query from a small ring.
+ * Results are read back only once the GPU reports them available,
+ * so the latest elapsed time lags a few frames behind and reading
+ * it never stalls the pipeline. If the GPU falls behind by the whole
+ * ring, passes are left unmeasured until a query frees up.
+ *
+ * Time elapsed queries cannot nest, so at most one timer may be
+ * active at once.
+ */
+class GpuTimer {
+public:
+    /**
+     * @brief Number of queries in flight before passes are skipped.
+     */
+    static constexpr std::size_t queryCount{ 4 };
+
+    /**
+     * @brief Creates the query objects.
+     *
+     * @throws std::runtime_error If query creation fails.
+     */
+    GpuTimer();
+
+    /**
+     * @brief Deletes the query objects.
+     */
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    GpuTimer(GpuTimer&&) = delete;
+    GpuTimer& operator=(GpuTimer&&) = delete;
+
+    /**
+     * @brief Reads back the finished queries and starts measuring a pass.
+     */
+    void begin() noexcept;
+
+    /**
+     * @brief Stops measuring the pass, does nothing if begin() skipped it.
+     */
+    void end() noexcept;
+
+    /**
+     * @brief Returns the GPU time of the latest pass whose result was read back.
+     */
+    [[nodiscard]] double getElapsedMs() const noexcept { return m_elapsedMs; }
+
+private:
+    void readBackResults() noexcept;
+
+    std::array<GLuint, queryCount> m_queries{};
+    std::size_t m_oldestPending{}; ///< Ring index of the oldest query without a read back result
+    std::size_t m_pendingCount{};
+    bool m_isActive{};
+    double m_elapsedMs{};
+};
+
+#endif // GPU_TIMER_H
@@ -0,0 +1,68 @@
+#include "image.h"
+
+#include <stb_image.h>
+
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+Image::Image(const std::filesystem::path& path) {
+    // The flip flag is thread-local, images may be decoded on worker threads.
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    m_data = stbi_load(path.string().c_str(), &m_width, &m_height, &m_nChannels, 0);
+    if (!m_data) {
+        throw std::runtime_error{ std::format("Failed to load texture: {}", path.generic_string()) };
+    }
+}
+
+Image::Image(const std::span<const unsigned char> encodedData) {
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    m_data = stbi_load_from_memory(
+        encodedData.data(),
+        static_cast<int>(encodedData.size()),
+        &m_width,
+        &m_height,
+        &m_nChannels,
+        0
+    );
+    if (!m_data) {
+        throw std::runtime_error{ std::format("Failed to decode an embedded texture: {}", stbi_failure_reason()) };
+    }
+}
+
+Image::Image(Image&& other) noexcept
+    : m_data     { std::exchange(other.m_data, nullptr) }
+    , m_width    { std::exchange(other.m_width, 0) }
+    , m_height   { std::exchange(other.m_height, 0) }
+    , m_nChannels{ std::exchange(other.m_nChannels, 0) }
+{}
+
+Image& Image::operator=(Image&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    freeData();
+
+    m_data      = std::exchange(other.m_data, nullptr);
+    m_width     = std::exchange(other.m_width, 0);
+    m_height    = std::exchange(other.m_height, 0);
+    m_nChannels = std::exchange(other.m_nChannels, 0);
+
+    return *this;
+}
+
+void Image::freeData() noexcept {
+    if (!m_data) {
+        return;
+    }
+
+    stbi_image_free(m_data);
+
+    m_data      = nullptr;
+    m_width     = 0;
+    m_height    = 0;
+    m_nChannels = 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <filesystem>
+#include <span>
+
+/**
+ * @brief Decoded 8-bit image in CPU memory.
+ *
+ * Decoding does not touch OpenGL, so images can be
+ * prepared on worker threads and uploaded later.
+ * Rows are flipped vertically to match OpenGL texture coordinates.
+ */
+class Image {
+public:
+    /**
+     * @brief Loads and decodes an image file.
+     *
+     * @throws std::runtime_error If the file cannot be decoded.
+     */
+    explicit Image(const std::filesystem::path& path);
+
+    /**
+     * @brief Decodes an encoded image (PNG, JPEG, ...) in memory.
+     *
+     * @throws std::runtime_error If the data cannot be decoded.
+     */
+    explicit Image(const std::span<const unsigned char> encodedData);
+
+    /**
+     * @brief Releases the pixel data.
+     */
+    ~Image() {
+        freeData();
+    }
+
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+
+    Image(Image&& other) noexcept;
+    Image& operator=(Image&& other) noexcept;
+
+    [[nodiscard]] const unsigned char* getData() const noexcept { return m_data; }
+    [[nodiscard]] int getWidth() const noexcept { return m_width; }
+    [[nodiscard]] int getHeight() const noexcept { return m_height; }
+    [[nodiscard]] int getChannelCount() const noexcept { return m_nChannels; }
+
+private:
+    void freeData() noexcept;
+
+    unsigned char* m_data{};
+    int m_width{};
+    int m_height{};
+    int m_nChannels{};
+};
+
+#endif // IMAGE_H
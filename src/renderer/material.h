@@ -3,19 +3,19 @@
 #ifndef MATERIAL_H
 #define MATERIAL_H
 
-#include "texture2d.h"
+#include "resource-handle.h"
 
 #include <glm/glm.hpp>
-#include <optional>
 
 /**
  * @brief Surface material description.
  *
  * Defines how a surface interacts with light,
  * including texture and specular properties.
+ * The diffuse texture is owned by the ResourceRegistry.
  */
 struct Material {
-    std::optional<Texture2D> diffuse{};
+    TextureHandle diffuse{};
     glm::vec3 specularColor{ 1.f };
     float specularStrength{ 1.f };
     float shininess{ 32.f };
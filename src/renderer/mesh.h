@@ -3,14 +3,12 @@
 #ifndef MESH_H
 #define MESH_H
 
+#include "resource-handle.h"
+
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 
 #include <span>
-#include <memory>
-
-struct aiMesh;
-struct Material;
 
 /**
  * @brief Single mesh vertex.
@@ -36,29 +34,14 @@ public:
      *
      * @param vertices Vertex data.
      * @param indices Index data.
-     * @param material Material shared by this mesh.
-     *
-     * @throws std::runtime_error If mesh creation fails.
-     */
-    Mesh(
-        const std::span<Vertex> vertices,
-        const std::span<GLuint> indices,
-        const std::shared_ptr<Material> material
-    );
-
-    /**
-     * @brief Creates a mesh from an Assimp mesh.
-     *
-     * @param mesh Assimp mesh source.
-     * @param material Material used by this mesh.
-     * @param transform Transform applied to vertex positions.
+     * @param material Handle of the material used by this mesh.
      *
      * @throws std::runtime_error If mesh creation fails.
      */
     Mesh(
-        const aiMesh& mesh,
-        const std::shared_ptr<Material> material,
-        const glm::mat4& transform = { 1.f }
+        const std::span<const Vertex> vertices,
+        const std::span<const GLuint> indices,
+        const MaterialHandle material
     );
 
     Mesh(const Mesh&) = delete;
@@ -79,12 +62,12 @@ public:
     [[nodiscard]] GLuint getEbo() const noexcept { return m_ebo; }
     [[nodiscard]] GLsizei getVertexCount() const noexcept { return m_vertexCount; }
     [[nodiscard]] GLsizei getIndexCount() const noexcept { return m_indexCount; }
-    [[nodiscard]] std::shared_ptr<Material> getMaterial() const noexcept { return m_material; }
+    [[nodiscard]] MaterialHandle getMaterial() const noexcept { return m_material; }
 
 private:
     void createMesh(
-        const std::span<Vertex> vertices,
-        const std::span<GLuint> indices
+        const std::span<const Vertex> vertices,
+        const std::span<const GLuint> indices
     );
     void deleteMesh() noexcept;
 
@@ -92,7 +75,7 @@ private:
     GLuint m_vbo{};
     GLuint m_ebo{};
 
-    std::shared_ptr<Material> m_material{};
+    MaterialHandle m_material{};
     GLsizei m_vertexCount{};
     GLsizei m_indexCount{};
 };
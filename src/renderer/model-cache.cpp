@@ -0,0 +1,338 @@
+#include "model-cache.h"
+
+#include "model-cooker.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+    constexpr std::array<char, 4> cacheMagic{ 'C', 'I', 'M', 'C' };
+    constexpr std::uint32_t cacheVersion{ 1 };
+    constexpr std::size_t blobAlignment{ 16 };
+
+    struct FileHeader {
+        std::array<char, 4> magic{};
+        std::uint32_t version{};
+        std::uint64_t sourceSize{};
+        std::int64_t sourceWriteTime{};
+        std::uint64_t transformHash{};
+        std::uint32_t materialCount{};
+        std::uint32_t meshCount{};
+    };
+
+    struct MaterialRecord {
+        std::array<float, 3> specularColor{};
+        float specularStrength{};
+        float shininess{};
+        std::uint32_t padding{};
+        std::uint64_t texturePathOffset{};
+        std::uint64_t texturePathSize{};
+        std::uint64_t embeddedTextureOffset{};
+        std::uint64_t embeddedTextureSize{};
+    };
+
+    struct MeshRecord {
+        std::uint32_t materialIndex{};
+        std::uint32_t padding{};
+        std::uint64_t vertexOffset{};
+        std::uint64_t vertexCount{};
+        std::uint64_t indexOffset{};
+        std::uint64_t indexCount{};
+    };
+
+    static_assert(std::is_trivially_copyable_v<Vertex>);
+    static_assert(sizeof(Vertex) == 8 * sizeof(float), "Vertex layout changed, bump cacheVersion");
+
+    struct SourceStamp {
+        std::uint64_t size{};
+        std::int64_t writeTime{};
+    };
+
+    [[nodiscard]] std::optional<SourceStamp> getSourceStamp(const std::filesystem::path& sourcePath) {
+        std::error_code error{};
+        const auto size{ std::filesystem::file_size(sourcePath, error) };
+        if (error) {
+            return std::nullopt;
+        }
+
+        const auto writeTime{ std::filesystem::last_write_time(sourcePath, error) };
+        if (error) {
+            return std::nullopt;
+        }
+
+        return SourceStamp{
+            .size{ size },
+            .writeTime{ static_cast<std::int64_t>(writeTime.time_since_epoch().count()) },
+        };
+    }
+
+    [[nodiscard]] std::uint64_t hashTransform(const glm::mat4& transform) noexcept {
+        // 64-bit FNV-1a over the matrix bytes, the transform is baked into the vertices.
+        const auto bytes{ std::bit_cast<std::array<unsigned char, sizeof(glm::mat4)>>(transform) };
+
+        std::uint64_t hash{ 14695981039346656037ull };
+        for (const unsigned char byte : bytes) {
+            hash ^= byte;
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    [[nodiscard]] bool isRangeValid(
+        const std::span<const std::byte> data,
+        const std::uint64_t offset,
+        const std::uint64_t count,
+        const std::size_t elementSize,
+        const std::size_t alignment
+    ) noexcept {
+        if (offset > data.size() || offset % alignment) {
+            return false;
+        }
+        return count <= (data.size() - offset) / elementSize;
+    }
+
+    template <typename T>
+    [[nodiscard]] std::span<const T> getRange(
+        const std::span<const std::byte> data,
+        const std::uint64_t offset,
+        const std::uint64_t count
+    ) noexcept {
+        return { reinterpret_cast<const T*>(data.data() + offset), static_cast<std::size_t>(count) };
+    }
+
+    /**
+     * @brief Appends a blob to the file buffer and returns its offset.
+     */
+    std::uint64_t appendBlob(
+        std::vector<std::byte>& buffer,
+        const void* const data,
+        const std::size_t size
+    ) {
+        buffer.resize((buffer.size() + blobAlignment - 1) / blobAlignment * blobAlignment);
+
+        const std::uint64_t offset{ buffer.size() };
+        buffer.resize(buffer.size() + size);
+        if (size) {
+            std::memcpy(buffer.data() + offset, data, size);
+        }
+
+        return offset;
+    }
+}
+
+std::optional<ModelCache> ModelCache::open(
+    const std::filesystem::path& sourcePath,
+    const glm::mat4& transform
+) {
+    const auto cachePath{ getCachePath(sourcePath, transform) };
+
+    std::error_code error{};
+    if (!std::filesystem::is_regular_file(cachePath, error)) {
+        return std::nullopt;
+    }
+
+    try {
+        ModelCache cache{ MappedFile{ cachePath } };
+        if (!cache.parse(sourcePath, hashTransform(transform))) {
+            return std::nullopt;
+        }
+        return cache;
+    } catch (const std::exception& exception) {
+        std::cerr << "Error when opening a model cache: " << exception.what() << '\n';
+        return std::nullopt;
+    }
+}
+
+void ModelCache::write(
+    const std::filesystem::path& sourcePath,
+    const glm::mat4& transform,
+    const CookedModel& model
+) {
+    const auto sourceStamp{ getSourceStamp(sourcePath) };
+    if (!sourceStamp) {
+        throw std::runtime_error{ std::format("Failed to stat model source: {}", sourcePath.generic_string()) };
+    }
+
+    const FileHeader header{
+        .magic{ cacheMagic },
+        .version{ cacheVersion },
+        .sourceSize{ sourceStamp->size },
+        .sourceWriteTime{ sourceStamp->writeTime },
+        .transformHash{ hashTransform(transform) },
+        .materialCount{ static_cast<std::uint32_t>(model.materials.size()) },
+        .meshCount{ static_cast<std::uint32_t>(model.meshes.size()) },
+    };
+
+    std::vector<MaterialRecord> materialRecords(model.materials.size());
+    std::vector<MeshRecord> meshRecords(model.meshes.size());
+
+    // Records are patched once the blob offsets are known.
+    std::vector<std::byte> buffer(sizeof(FileHeader));
+    const std::uint64_t materialRecordsOffset{ appendBlob(buffer, materialRecords.data(), materialRecords.size() * sizeof(MaterialRecord)) };
+    const std::uint64_t meshRecordsOffset{ appendBlob(buffer, meshRecords.data(), meshRecords.size() * sizeof(MeshRecord)) };
+
+    for (std::size_t i{}; i < model.materials.size(); ++i) {
+        const CookedMaterial& material{ model.materials[i] };
+        const std::string texturePath{ material.texturePath.generic_string() };
+
+        materialRecords[i] = {
+            .specularColor{ material.specularColor.r, material.specularColor.g, material.specularColor.b },
+            .specularStrength{ material.specularStrength },
+            .shininess{ material.shininess },
+            .texturePathOffset{ appendBlob(buffer, texturePath.data(), texturePath.size()) },
+            .texturePathSize{ texturePath.size() },
+            .embeddedTextureOffset{ appendBlob(buffer, material.embeddedTexture.data(), material.embeddedTexture.size()) },
+            .embeddedTextureSize{ material.embeddedTexture.size() },
+        };
+    }
+
+    for (std::size_t i{}; i < model.meshes.size(); ++i) {
+        const CookedMesh& mesh{ model.meshes[i] };
+
+        meshRecords[i] = {
+            .materialIndex{ mesh.materialIndex },
+            .vertexOffset{ appendBlob(buffer, mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex)) },
+            .vertexCount{ mesh.vertices.size() },
+            .indexOffset{ appendBlob(buffer, mesh.indices.data(), mesh.indices.size() * sizeof(GLuint)) },
+            .indexCount{ mesh.indices.size() },
+        };
+    }
+
+    std::memcpy(buffer.data(), &header, sizeof(FileHeader));
+    std::memcpy(buffer.data() + materialRecordsOffset, materialRecords.data(), materialRecords.size() * sizeof(MaterialRecord));
+    std::memcpy(buffer.data() + meshRecordsOffset, meshRecords.data(), meshRecords.size() * sizeof(MeshRecord));
+
+    // Write to a temporary file first so a crash never leaves a truncated cache behind.
+    const auto cachePath{ getCachePath(sourcePath, transform) };
+    auto temporaryPath{ cachePath };
+    temporaryPath += ".tmp";
+
+    {
+        std::ofstream file{ temporaryPath, std::ios::binary | std::ios::trunc };
+        if (!file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+            throw std::runtime_error{ std::format("Failed to write model cache: {}", temporaryPath.generic_string()) };
+        }
+    }
+
+    std::error_code error{};
+    std::filesystem::rename(temporaryPath, cachePath, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        throw std::runtime_error{ std::format("Failed to write model cache: {}", cachePath.generic_string()) };
+    }
+}
+
+std::filesystem::path ModelCache::getCachePath(
+    const std::filesystem::path& sourcePath,
+    const glm::mat4& transform
+) {
+    auto cachePath{ sourcePath };
+    cachePath += std::format(".{:016x}.modelcache", hashTransform(transform));
+    return cachePath;
+}
+
+ModelView ModelCache::makeView(const CookedModel& model) {
+    ModelView view{};
+
+    view.materials.reserve(model.materials.size());
+    for (const auto& material : model.materials) {
+        view.materials.push_back({
+            .specularColor{ material.specularColor },
+            .specularStrength{ material.specularStrength },
+            .shininess{ material.shininess },
+            .embeddedTexture{ material.embeddedTexture },
+        });
+    }
+
+    view.meshes.reserve(model.meshes.size());
+    for (const auto& mesh : model.meshes) {
+        view.meshes.push_back({
+            .vertices{ mesh.vertices },
+            .indices{ mesh.indices },
+            .materialIndex{ mesh.materialIndex },
+        });
+    }
+
+    return view;
+}
+
+bool ModelCache::parse(
+    const std::filesystem::path& sourcePath,
+    const std::uint64_t transformHash
+) {
+    const std::span<const std::byte> data{ m_file.getData() };
+    if (data.size() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(&header, data.data(), sizeof(FileHeader));
+
+    if (header.magic != cacheMagic || header.version != cacheVersion || header.transformHash != transformHash) {
+        return false;
+    }
+
+    // A missing source is fine, shipped builds may only contain the cache.
+    if (const auto sourceStamp{ getSourceStamp(sourcePath) }) {
+        if (sourceStamp->size != header.sourceSize || sourceStamp->writeTime != header.sourceWriteTime) {
+            return false;
+        }
+    }
+
+    const std::uint64_t materialRecordsOffset{ blobAlignment * ((sizeof(FileHeader) + blobAlignment - 1) / blobAlignment) };
+    if (!isRangeValid(data, materialRecordsOffset, header.materialCount, sizeof(MaterialRecord), alignof(MaterialRecord))) {
+        return false;
+    }
+
+    const std::uint64_t meshRecordsOffset{ blobAlignment * ((materialRecordsOffset + header.materialCount * sizeof(MaterialRecord) + blobAlignment - 1) / blobAlignment) };
+    if (!isRangeValid(data, meshRecordsOffset, header.meshCount, sizeof(MeshRecord), alignof(MeshRecord))) {
+        return false;
+    }
+
+    m_view.materials.reserve(header.materialCount);
+    for (const MaterialRecord& record : getRange<MaterialRecord>(data, materialRecordsOffset, header.materialCount)) {
+        if (!isRangeValid(data, record.texturePathOffset, record.texturePathSize, sizeof(char), alignof(char))
+            || !isRangeValid(data, record.embeddedTextureOffset, record.embeddedTextureSize, sizeof(unsigned char), alignof(unsigned char))) {
+            return false;
+        }
+
+        const auto texturePath{ getRange<char>(data, record.texturePathOffset, record.texturePathSize) };
+        m_view.materials.push_back({
+            .specularColor{ record.specularColor[0], record.specularColor[1], record.specularColor[2] },
+            .specularStrength{ record.specularStrength },
+            .shininess{ record.shininess },
+            .texturePath{ texturePath.data(), texturePath.size() },
+            .embeddedTexture{ getRange<unsigned char>(data, record.embeddedTextureOffset, record.embeddedTextureSize) },
+        });
+    }
+
+    m_view.meshes.reserve(header.meshCount);
+    for (const MeshRecord& record : getRange<MeshRecord>(data, meshRecordsOffset, header.meshCount)) {
+        if (record.materialIndex >= header.materialCount
+            || !isRangeValid(data, record.vertexOffset, record.vertexCount, sizeof(Vertex), alignof(Vertex))
+            || !isRangeValid(data, record.indexOffset, record.indexCount, sizeof(GLuint), alignof(GLuint))) {
+            return false;
+        }
+
+        const auto indices{ getRange<GLuint>(data, record.indexOffset, record.indexCount) };
+        if (std::ranges::any_of(indices, [&record](const GLuint index) { return index >= record.vertexCount; })) {
+            return false;
+        }
+
+        m_view.meshes.push_back({
+            .vertices{ getRange<Vertex>(data, record.vertexOffset, record.vertexCount) },
+            .indices{ indices },
+            .materialIndex{ record.materialIndex },
+        });
+    }
+
+    return true;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include "mesh.h"
+#include "core/mapped-file.h"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct CookedModel;
+
+/**
+ * @brief Non-owning view of model data ready for upload.
+ *
+ * Points either into a memory-mapped cache file
+ * or into a freshly cooked model.
+ */
+struct ModelView {
+    struct MaterialView {
+        glm::vec3 specularColor{ 1.f };
+        float specularStrength{ 1.f };
+        float shininess{ 32.f };
+        std::string_view texturePath{};
+        std::span<const unsigned char> embeddedTexture{};
+    };
+
+    struct MeshView {
+        std::span<const Vertex> vertices{};
+        std::span<const GLuint> indices{};
+        std::uint32_t materialIndex{};
+    };
+
+    std::vector<MaterialView> materials{};
+    std::vector<MeshView> meshes{};
+};
+
+/**
+ * @brief Binary, memory-mappable cache of a cooked model.
+ *
+ * The file stores interleaved vertices, indices, material parameters
+ * and texture references so a model can be uploaded without running Assimp.
+ * A cache is keyed by the source file and the baked root transform,
+ * and goes stale when the size or write time of the source changes.
+ */
+class ModelCache {
+public:
+    /**
+     * @brief Opens the cache of a model if it exists and is up to date.
+     *
+     * @param sourcePath Path to the source model file.
+     * @param transform Root transform baked into the cached vertices.
+     *
+     * @return Mapped cache, or std::nullopt if it is missing, stale or corrupt.
+     */
+    [[nodiscard]] static std::optional<ModelCache> open(
+        const std::filesystem::path& sourcePath,
+        const glm::mat4& transform
+    );
+
+    /**
+     * @brief Writes the cache of a cooked model next to its source file.
+     *
+     * @param sourcePath Path to the source model file.
+     * @param transform Root transform baked into the cooked vertices.
+     * @param model Cooked model data.
+     *
+     * @throws std::runtime_error If the cache file cannot be written.
+     */
+    static void write(
+        const std::filesystem::path& sourcePath,
+        const glm::mat4& transform,
+        const CookedModel& model
+    );
+
+    /**
+     * @brief Returns the cache file path of a model.
+     */
+    [[nodiscard]] static std::filesystem::path getCachePath(
+        const std::filesystem::path& sourcePath,
+        const glm::mat4& transform
+    );
+
+    /**
+     * @brief Creates a view of a cooked model.
+     */
+    [[nodiscard]] static ModelView makeView(const CookedModel& model);
+
+    /**
+     * @brief Returns a view of the mapped model data.
+     *
+     * The view is valid for the lifetime of the cache object.
+     */
+    [[nodiscard]] const ModelView& getView() const noexcept {
+        return m_view;
+    }
+
+private:
+    explicit ModelCache(MappedFile&& file) noexcept
+        : m_file{ std::move(file) } {}
+
+    [[nodiscard]] bool parse(
+        const std::filesystem::path& sourcePath,
+        const std::uint64_t transformHash
+    );
+
+    MappedFile m_file;
+    ModelView m_view{};
+};
+
+#endif // MODEL_CACHE_H
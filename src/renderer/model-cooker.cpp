@@ -0,0 +1,166 @@
+#include "model-cooker.h"
+
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+[[nodiscard]] static std::filesystem::path findTextureInAssets(
+    const std::filesystem::path& searchRoot,
+    const std::filesystem::path& fullTexturePath
+) {
+    if (!std::filesystem::exists(searchRoot) || !std::filesystem::is_directory(searchRoot)) {
+        throw std::runtime_error{ std::format(R"("{}" is not a directory.)", searchRoot.generic_string()) };
+    }
+
+    const auto texturePathString{ fullTexturePath.string() };
+    std::string_view targetFileName{ texturePathString };
+
+    const auto lastSeparatorPos{ targetFileName.find_last_of("\\/") };
+    if (lastSeparatorPos != std::string_view::npos) {
+        targetFileName.remove_prefix(lastSeparatorPos + 1);
+    }
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator{ searchRoot }) {
+        if (entry.is_regular_file() && entry.path().filename() == targetFileName) {
+            return entry.path();
+        }
+    }
+
+    throw std::runtime_error{ std::format(R"("{}" was not found.)", texturePathString) };
+}
+
+[[nodiscard]] static CookedMaterial cookMaterial(
+    const aiScene* const scene,
+    const aiMaterial* const material,
+    const std::filesystem::path& modelPath
+) {
+    CookedMaterial cookedMaterial{};
+
+    if (!material->GetTextureCount(aiTextureType_DIFFUSE)) {
+        return cookedMaterial;
+    }
+
+    aiString texturePath{};
+    material->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath);
+    try {
+        if (texturePath.C_Str()[0] != '*') {
+            cookedMaterial.texturePath = findTextureInAssets(modelPath.parent_path(), texturePath.C_Str());
+            return cookedMaterial;
+        }
+
+        const int textureIndex{ std::atoi(texturePath.C_Str() + 1) };
+        if (textureIndex < 0 || static_cast<unsigned int>(textureIndex) >= scene->mNumTextures) {
+            throw std::runtime_error{ std::format("Invalid embedded texture reference: {}", texturePath.C_Str()) };
+        }
+
+        // mHeight is zero for compressed textures, mWidth is then the size in bytes.
+        const aiTexture& texture{ *scene->mTextures[textureIndex] };
+        if (texture.mHeight) {
+            throw std::runtime_error{ std::format("Uncompressed embedded texture is not supported: {}", texture.mFilename.C_Str()) };
+        }
+
+        const auto* const textureData{ reinterpret_cast<const unsigned char*>(texture.pcData) };
+        cookedMaterial.embeddedTexture.assign(textureData, textureData + texture.mWidth);
+    } catch (const std::exception& exception) {
+        std::cerr << "Error when loading a texture: " << exception.what() << '\n';
+    }
+
+    return cookedMaterial;
+}
+
+[[nodiscard]] static CookedMesh cookMesh(
+    const aiMesh& mesh,
+    const glm::mat4& transform
+) {
+    CookedMesh cookedMesh{ .materialIndex{ mesh.mMaterialIndex } };
+    cookedMesh.vertices.reserve(mesh.mNumVertices);
+    cookedMesh.indices.reserve(mesh.mNumFaces * 3); // Assumes aiProcess_Triangulate was used
+
+    const bool hasNormals{ mesh.HasNormals() };
+    const bool hasTextureCoords{ mesh.HasTextureCoords(0) };
+    const glm::mat3 normalMatrix{ glm::transpose(glm::inverse(glm::mat3{ transform })) };
+
+    for (unsigned int i{}; i < mesh.mNumVertices; ++i) {
+        cookedMesh.vertices.emplace_back(
+            glm::vec3{ transform * glm::vec4{
+                mesh.mVertices[i].x,
+                mesh.mVertices[i].y,
+                mesh.mVertices[i].z,
+                1.f
+            } },
+            hasNormals ? glm::normalize(normalMatrix * glm::vec3{
+                mesh.mNormals[i].x,
+                mesh.mNormals[i].y,
+                mesh.mNormals[i].z
+            }) : glm::vec3{},
+            hasTextureCoords ? glm::vec2{
+                mesh.mTextureCoords[0][i].x,
+                mesh.mTextureCoords[0][i].y
+            } : glm::vec2{}
+        );
+    }
+
+    for (unsigned int i{}; i < mesh.mNumFaces; ++i) {
+        const aiFace& face{ mesh.mFaces[i] };
+        for (unsigned int j{}; j < face.mNumIndices; ++j) {
+            cookedMesh.indices.push_back(face.mIndices[j]);
+        }
+    }
+
+    return cookedMesh;
+}
+
+static void cookNode(
+    const aiScene* const scene,
+    const aiNode* const node,
+    const glm::mat4& parentTransform,
+    CookedModel& cookedModel
+) {
+    const aiMatrix4x4& from{ node->mTransformation };
+    const glm::mat4 nodeTransform{ parentTransform * glm::mat4{
+        from.a1, from.b1, from.c1, from.d1,
+        from.a2, from.b2, from.c2, from.d2,
+        from.a3, from.b3, from.c3, from.d3,
+        from.a4, from.b4, from.c4, from.d4,
+    } };
+
+    for (unsigned int i{}; i < node->mNumMeshes; ++i) {
+        cookedModel.meshes.push_back(cookMesh(*scene->mMeshes[node->mMeshes[i]], nodeTransform));
+    }
+
+    for (unsigned int i{}; i < node->mNumChildren; ++i) {
+        cookNode(scene, node->mChildren[i], nodeTransform, cookedModel);
+    }
+}
+
+CookedModel cookModel(
+    const std::filesystem::path& path,
+    const glm::mat4& transform
+) {
+    Assimp::Importer importer{};
+    const aiScene* scene{ importer.ReadFile(
+        path.string(),
+        aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_FlipUVs
+    ) };
+    if (!scene) {
+        throw std::runtime_error{ std::format("Assimp failed to parse: {}", path.generic_string()) };
+    }
+
+    CookedModel cookedModel{};
+
+    cookedModel.materials.reserve(scene->mNumMaterials);
+    for (unsigned int i{}; i < scene->mNumMaterials; ++i) {
+        cookedModel.materials.push_back(cookMaterial(scene, scene->mMaterials[i], path));
+    }
+
+    cookedModel.meshes.reserve(scene->mNumMeshes);
+    cookNode(scene, scene->mRootNode, transform, cookedModel);
+
+    return cookedModel;
+}
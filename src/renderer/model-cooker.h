@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef MODEL_COOKER_H
+#define MODEL_COOKER_H
+
+#include "mesh.h"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/**
+ * @brief CPU-side material data extracted from a model file.
+ */
+struct CookedMaterial {
+    glm::vec3 specularColor{ 1.f };
+    float specularStrength{ 1.f };
+    float shininess{ 32.f };
+
+    /// Diffuse texture file, empty if the material has none or it is embedded.
+    std::filesystem::path texturePath{};
+    /// Encoded (PNG, JPEG, ...) diffuse texture embedded in the model file.
+    std::vector<unsigned char> embeddedTexture{};
+};
+
+/**
+ * @brief CPU-side mesh data ready for upload.
+ *
+ * Node transforms and the model root transform are already
+ * applied to the vertices.
+ */
+struct CookedMesh {
+    std::vector<Vertex> vertices{};
+    std::vector<GLuint> indices{};
+    std::uint32_t materialIndex{};
+};
+
+/**
+ * @brief Model data imported from disk without touching OpenGL.
+ */
+struct CookedModel {
+    std::vector<CookedMaterial> materials{};
+    std::vector<CookedMesh> meshes{};
+};
+
+/**
+ * @brief Imports a model file using Assimp.
+ *
+ * Safe to call without an OpenGL context.
+ *
+ * @param path Path to the model file.
+ * @param transform Root transform baked into the vertices.
+ *
+ * @throws std::runtime_error If assimp fails to parse the file.
+ */
+[[nodiscard]] CookedModel cookModel(
+    const std::filesystem::path& path,
+    const glm::mat4& transform = { 1.f }
+);
+
+#endif // MODEL_COOKER_H
@@ -0,0 +1,37 @@
+#include "model-source.h"
+
+#include <iostream>
+
+ModelSource::ModelSource(
+    const std::filesystem::path& path,
+    const glm::mat4& transform
+) : m_cache{ ModelCache::open(path, transform) } {
+    if (!m_cache) {
+        m_cookedModel = cookModel(path, transform);
+
+        try {
+            ModelCache::write(path, transform, m_cookedModel);
+        } catch (const std::exception& exception) {
+            std::cerr << "Error when writing a model cache: " << exception.what() << '\n';
+        }
+
+        m_cookedView = ModelCache::makeView(m_cookedModel);
+    }
+
+    const ModelView& view{ getView() };
+    m_textures.reserve(view.materials.size());
+
+    for (const auto& material : view.materials) {
+        auto& texture{ m_textures.emplace_back() };
+
+        try {
+            if (!material.embeddedTexture.empty()) {
+                texture.emplace(material.embeddedTexture);
+            } else if (!material.texturePath.empty()) {
+                texture.emplace(std::filesystem::path{ material.texturePath });
+            }
+        } catch (const std::exception& exception) {
+            std::cerr << "Error when loading a texture: " << exception.what() << '\n';
+        }
+    }
+}
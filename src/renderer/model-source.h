@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef MODEL_SOURCE_H
+#define MODEL_SOURCE_H
+
+#include "image.h"
+#include "model-cache.h"
+#include "model-cooker.h"
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Model data read and decoded on the CPU, ready for upload.
+ *
+ * Preparing a source maps the model cache (or runs Assimp when it is
+ * missing or stale) and decodes all textures without touching OpenGL,
+ * so it can run on a worker thread. Only the upload in
+ * Model::Model(const ModelSource&) needs the OpenGL context.
+ */
+class ModelSource {
+public:
+    /**
+     * @brief Reads a model and decodes its textures.
+     *
+     * @param path Path to the model file.
+     * @param transform Root transform applied to the model.
+     *
+     * @throws std::runtime_error If assimp fails to parse the file.
+     */
+    ModelSource(
+        const std::filesystem::path& path,
+        const glm::mat4& transform
+    );
+
+    ModelSource(const ModelSource&) = delete;
+    ModelSource& operator=(const ModelSource&) = delete;
+
+    ModelSource(ModelSource&& other) noexcept = default;
+    ModelSource& operator=(ModelSource&& other) noexcept = default;
+
+    [[nodiscard]] const ModelView& getView() const noexcept {
+        return m_cache ? m_cache->getView() : m_cookedView;
+    }
+
+    /**
+     * @brief Returns the decoded diffuse texture of each material.
+     *
+     * Materials without a texture, or whose texture failed
+     * to decode, have no value.
+     */
+    [[nodiscard]] const std::vector<std::optional<Image>>& getTextures() const noexcept {
+        return m_textures;
+    }
+
+private:
+    std::optional<ModelCache> m_cache{};
+    CookedModel m_cookedModel{};
+    ModelView m_cookedView{};
+    std::vector<std::optional<Image>> m_textures{};
+};
+
+#endif // MODEL_SOURCE_H
@@ -1,24 +1,299 @@
 #include "model-store.h"
 
 #include "model.h"
+#include "model-source.h"
+#include "resource-registry.h"
+
+#include <core/profiler.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-std::shared_ptr<Model> ModelStore::load(
+#include <algorithm>
+#include <iostream>
+
+ModelStore::ModelStore(JobSystem& jobSystem, const bool loadGeometry)
+    : m_jobSystem{ &jobSystem }
+    , m_resources{ std::make_unique<ResourceRegistry>() }
+    , m_loadGeometry{ loadGeometry } {}
+
+ModelStore::ModelStore(ModelStore&& other) noexcept = default;
+ModelStore& ModelStore::operator=(ModelStore&& other) noexcept = default;
+
+ModelStore::~ModelStore() {
+    for (const auto& pending : m_pendingUploads) {
+        m_jobSystem->wait(pending.job);
+    }
+}
+
+ModelHandle ModelStore::load(
     const std::filesystem::path& path,
     const float scale
 ) {
-    auto& modelScalesMap{ m_modelCache[path] };
+    PROFILE_ZONE("ModelStore::load");
 
-    const auto it{ modelScalesMap.find(scale) };
-    if (it != modelScalesMap.end()) {
-        if (auto modelPtr{ it->second.lock() }) {
-            return modelPtr;
-        }
+    if (!m_loadGeometry) {
+        return {};
+    }
+
+    const ModelHandle model{ getVariant(acquire(path, false), scale) };
+    evictOverBudget();
+
+    return model;
+}
+
+ModelHandle ModelStore::loadAsync(
+    const std::filesystem::path& path,
+    const float scale
+) {
+    PROFILE_ZONE("ModelStore::loadAsync");
+
+    if (!m_loadGeometry) {
+        return {};
     }
 
-    const auto model{ std::make_shared<Model>(path, glm::scale(glm::mat4{ 1.f }, glm::vec3{ scale }))};
-    modelScalesMap[scale] = model;
+    const ModelHandle model{ getVariant(acquire(path, true), scale) };
+    evictOverBudget();
+
     return model;
 }
+
+void ModelStore::pin(const std::filesystem::path& path) {
+    if (!m_loadGeometry) {
+        return;
+    }
+
+    acquire(path, true, false).isPinned = true;
+}
+
+void ModelStore::unpin(const std::filesystem::path& path) {
+    const auto it{ m_geometries.find(path) };
+    if (it == m_geometries.end()) {
+        return;
+    }
+
+    it->second.isPinned = false;
+    evictOverBudget();
+}
+
+void ModelStore::addReference(const ModelHandle model) {
+    if (!m_resources->get(model)) {
+        return;
+    }
+
+    if (model.getIndex() >= m_modelReferences.size()) {
+        m_modelReferences.resize(model.getIndex() + 1);
+    }
+    ++m_modelReferences[model.getIndex()];
+}
+
+void ModelStore::removeReference(const ModelHandle model) noexcept {
+    if (!m_resources->get(model) || model.getIndex() >= m_modelReferences.size()) {
+        return;
+    }
+
+    auto& references{ m_modelReferences[model.getIndex()] };
+    references -= references > 0;
+}
+
+void ModelStore::processUploads(const std::chrono::steady_clock::duration budget) {
+    PROFILE_ZONE("ModelStore::processUploads");
+    const auto startTime{ std::chrono::steady_clock::now() };
+    bool uploadedAny{};
+
+    for (auto it{ m_pendingUploads.begin() }; it != m_pendingUploads.end();) {
+        if (uploadedAny && std::chrono::steady_clock::now() - startTime >= budget) {
+            break;
+        }
+
+        if (!it->job.isDone()) {
+            ++it;
+            continue;
+        }
+
+        try {
+            finishUpload(*it);
+        } catch (const std::exception& exception) {
+            std::cerr << "Error when loading a model " << it->path.generic_string() << ": " << exception.what() << '\n';
+        }
+
+        uploadedAny = true;
+        it = m_pendingUploads.erase(it);
+    }
+
+    evictOverBudget();
+}
+
+void ModelStore::setRetentionPolicy(const RetentionPolicy& policy) {
+    m_retentionPolicy = policy;
+    evictOverBudget();
+}
+
+ModelStore::CachedGeometry& ModelStore::acquire(
+    const std::filesystem::path& path,
+    const bool async,
+    const bool isLookup
+) {
+    if (const auto it{ m_geometries.find(path) }; it != m_geometries.end()) {
+        m_stats.hits += isLookup;
+        it->second.lastUse = ++m_useCounter;
+
+        if (!async) {
+            const auto pending{ std::ranges::find(m_pendingUploads, it->second.geometry, &PendingUpload::geometry) };
+            if (pending != m_pendingUploads.end()) {
+                PendingUpload upload{ std::move(*pending) };
+                m_pendingUploads.erase(pending);
+                finishUpload(upload);
+            }
+        }
+
+        return it->second;
+    }
+
+    m_stats.misses += isLookup;
+    if (m_evictedPaths.erase(path) && isLookup) {
+        ++m_stats.reloads;
+    }
+
+    if (!async) {
+        ModelGeometry geometry{ *m_resources, ModelSource{ path, glm::mat4{ 1.f } } };
+        CachedGeometry& cachedGeometry{ m_geometries[path] = {
+            .geometry{ m_resources->emplace<ModelGeometry>(std::move(geometry)) },
+            .lastUse{ ++m_useCounter },
+        } };
+        updateByteSize(cachedGeometry);
+        return cachedGeometry;
+    }
+
+    // The empty geometry is filled in place once uploaded, so models sharing it see the result.
+    const GeometryHandle geometry{ m_resources->emplace<ModelGeometry>() };
+
+    auto result{ std::make_shared<LoadResult>() };
+    JobHandle job{ m_jobSystem->schedule([path, result] {
+        PROFILE_ZONE("ModelStore::parse");
+        try {
+            result->source = std::make_unique<ModelSource>(path, glm::mat4{ 1.f });
+        } catch (...) {
+            result->error = std::current_exception();
+        }
+    }) };
+
+    m_pendingUploads.push_back({
+        .geometry{ geometry },
+        .job{ std::move(job) },
+        .result{ std::move(result) },
+        .path{ path },
+    });
+
+    return m_geometries[path] = {
+        .geometry{ geometry },
+        .lastUse{ ++m_useCounter },
+    };
+}
+
+ModelHandle ModelStore::getVariant(
+    CachedGeometry& cachedGeometry,
+    const float scale
+) {
+    auto& variant{ cachedGeometry.variants[scale] };
+    if (!variant.isValid()) {
+        variant = m_resources->emplace<Model>(cachedGeometry.geometry, glm::scale(glm::mat4{ 1.f }, glm::vec3{ scale }));
+        updateByteSize(cachedGeometry);
+    }
+
+    return variant;
+}
+
+void ModelStore::finishUpload(PendingUpload& pending) {
+    m_jobSystem->wait(pending.job);
+
+    try {
+        if (pending.result->error) {
+            std::rethrow_exception(pending.result->error);
+        }
+
+        ModelGeometry geometry{ *m_resources, *pending.result->source };
+        *m_resources->get(pending.geometry) = std::move(geometry);
+    } catch (...) {
+        // Holders keep stale handles, the next load retries from disk.
+        erase(pending.path);
+        throw;
+    }
+
+    const auto it{ m_geometries.find(pending.path) };
+    if (it != m_geometries.end()) {
+        updateByteSize(it->second);
+    }
+}
+
+void ModelStore::updateByteSize(CachedGeometry& cachedGeometry) noexcept {
+    m_stats.cpuBytes -= cachedGeometry.cpuByteSize;
+    m_stats.gpuBytes -= cachedGeometry.gpuByteSize;
+
+    const ModelGeometry& geometry{ *m_resources->get(cachedGeometry.geometry) };
+    cachedGeometry.cpuByteSize = geometry.getCpuByteSize() + cachedGeometry.variants.size() * sizeof(Model);
+    cachedGeometry.gpuByteSize = geometry.getGpuByteSize();
+
+    m_stats.cpuBytes += cachedGeometry.cpuByteSize;
+    m_stats.gpuBytes += cachedGeometry.gpuByteSize;
+}
+
+void ModelStore::erase(const std::filesystem::path& path) noexcept {
+    const auto it{ m_geometries.find(path) };
+    if (it == m_geometries.end()) {
+        return;
+    }
+
+    m_stats.cpuBytes -= it->second.cpuByteSize;
+    m_stats.gpuBytes -= it->second.gpuByteSize;
+
+    for (const auto& [scale, model] : it->second.variants) {
+        if (model.getIndex() < m_modelReferences.size()) {
+            m_modelReferences[model.getIndex()] = 0;
+        }
+        m_resources->erase(model);
+    }
+    m_resources->destroyGeometry(it->second.geometry);
+    m_geometries.erase(it);
+}
+
+void ModelStore::evictOverBudget() {
+    const auto isOverBudget{ [this] {
+        return m_stats.cpuBytes > m_retentionPolicy.cpuByteBudget
+            || m_stats.gpuBytes > m_retentionPolicy.gpuByteBudget;
+    } };
+
+    while (isOverBudget()) {
+        auto leastRecentlyUsed{ m_geometries.end() };
+        for (auto it{ m_geometries.begin() }; it != m_geometries.end(); ++it) {
+            if (!isEvictable(it->second)) {
+                continue;
+            }
+            if (leastRecentlyUsed == m_geometries.end() || it->second.lastUse < leastRecentlyUsed->second.lastUse) {
+                leastRecentlyUsed = it;
+            }
+        }
+
+        if (leastRecentlyUsed == m_geometries.end()) {
+            return;
+        }
+
+        m_evictedPaths.insert(leastRecentlyUsed->first);
+        ++m_stats.evictions;
+        erase(leastRecentlyUsed->first);
+    }
+}
+
+bool ModelStore::isEvictable(const CachedGeometry& cachedGeometry) const noexcept {
+    if (cachedGeometry.isPinned) {
+        return false;
+    }
+
+    const bool hasUsedVariant{ std::ranges::any_of(cachedGeometry.variants, [this](const auto& variant) {
+        const std::uint32_t index{ variant.second.getIndex() };
+        return index < m_modelReferences.size() && m_modelReferences[index] > 0;
+    }) };
+    const bool isPending{ std::ranges::find(m_pendingUploads, cachedGeometry.geometry, &PendingUpload::geometry) != m_pendingUploads.end() };
+
+    return !hasUsedVariant && !isPending;
+}
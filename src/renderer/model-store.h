@@ -3,48 +3,268 @@
 #ifndef MODEL_STORE_H
 #define MODEL_STORE_H
 
+#include "resource-handle.h"
+
+#include <core/job-system.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <utility>
+#include <vector>
 
-class Model;
+class ModelSource;
+class ResourceRegistry;
 
 /**
  * @brief Centralized cache for loaded models.
  *
- * Prevents loading the same model multiple times
- * for identical scale values.
+ * Geometry is loaded once per model file and shared by every scale
+ * variant, the scale is applied per instance through Model::getTransform().
+ * The store owns the ResourceRegistry holding every model, geometry,
+ * mesh, material and texture, and hands out ModelHandle values.
+ * Models can be loaded either synchronously, or asynchronously with
+ * parsing and decoding as JobSystem jobs and the OpenGL upload deferred
+ * to processUploads().
+ *
+ * Loaded geometry stays resident after its last user is gone, until
+ * the store exceeds the CPU or GPU byte budget of its RetentionPolicy.
+ * The least recently used geometry that is neither pinned nor in use
+ * is evicted first. A model is in use while it has references, taken
+ * with addReference() by whoever stores its handle.
  */
 class ModelStore {
 public:
-    ModelStore() = default;
+    /**
+     * @brief Memory budgets for models kept resident without users.
+     */
+    struct RetentionPolicy {
+        std::size_t cpuByteBudget{ 64u << 20 };
+        std::size_t gpuByteBudget{ 256u << 20 };
+    };
+
+    /**
+     * @brief Cache counters and resident memory.
+     */
+    struct Stats {
+        std::size_t hits{};      ///< Loads served by resident or pending geometry
+        std::size_t misses{};    ///< Loads that had to read the model file
+        std::size_t reloads{};   ///< Misses of geometry that was loaded and evicted before
+        std::size_t evictions{}; ///< Geometry dropped to stay within the budget
+        std::size_t cpuBytes{};  ///< Approximate CPU memory of resident models
+        std::size_t gpuBytes{};  ///< Approximate GPU memory of resident models
+    };
+
+    /**
+     * @brief Constructs the store.
+     *
+     * @param jobSystem Runs asynchronous loads, must outlive the store.
+     * @param loadGeometry When false, no files are parsed and no GPU resources
+     *        are created, every load returns an invalid handle instead.
+     *        Allows running the game logic without an OpenGL context.
+     */
+    explicit ModelStore(JobSystem& jobSystem, const bool loadGeometry = true);
 
     ModelStore(const ModelStore&) = delete;
     ModelStore& operator=(const ModelStore&) = delete;
 
-    ModelStore(ModelStore&& other) noexcept = default;
-    ModelStore& operator=(ModelStore&& other) noexcept = default;
+    ModelStore(ModelStore&& other) noexcept;
+    ModelStore& operator=(ModelStore&& other) noexcept;
+
+    /**
+     * @brief Waits for the jobs of pending loads and drops their results.
+     */
+    ~ModelStore();
 
     /**
      * @brief Loads or retrieves a cached model.
      *
+     * If the model is still being loaded asynchronously,
+     * helps finishing its job and uploads it right away.
+     *
      * @param path Model file path.
      * @param scale Uniform scale applied to the model.
      *
      * @throws std::runtime_error If assimp fails to parse the file
      *         or the mesh creation fails.
      *
-     * @return Shared pointer to the model.
+     * @return Handle of the model.
+     */
+    [[nodiscard]] ModelHandle load(
+        const std::filesystem::path& path,
+        const float scale = { 1.f }
+    );
+
+    /**
+     * @brief Loads or retrieves a cached model without blocking.
+     *
+     * The returned model is empty until a later processUploads()
+     * call uploads its geometry, the handle itself stays the same.
+     * Load errors are reported there and leave the handle stale.
+     *
+     * @param path Model file path.
+     * @param scale Uniform scale applied to the model.
+     *
+     * @return Handle of the model.
      */
-    [[nodiscard]] std::shared_ptr<Model> load(
+    [[nodiscard]] ModelHandle loadAsync(
         const std::filesystem::path& path,
         const float scale = { 1.f }
     );
 
+    /**
+     * @brief Loads a model geometry asynchronously and keeps it resident regardless of the budget.
+     *
+     * Pinning is no lookup, it counts neither as a hit nor as a miss.
+     *
+     * @param path Model file path.
+     */
+    void pin(const std::filesystem::path& path);
+
+    /**
+     * @brief Makes a pinned model geometry evictable again.
+     *
+     * @param path Model file path.
+     */
+    void unpin(const std::filesystem::path& path);
+
+    /**
+     * @brief Marks a model as in use, which prevents the eviction of its geometry.
+     *
+     * Stale and invalid handles are ignored.
+     */
+    void addReference(const ModelHandle model);
+
+    /**
+     * @brief Releases a reference taken with addReference().
+     *
+     * Stale and invalid handles are ignored.
+     */
+    void removeReference(const ModelHandle model) noexcept;
+
+    /**
+     * @brief Uploads asynchronously loaded models that are ready.
+     *
+     * Must be called on the thread owning the OpenGL context.
+     * Stops once the time budget is spent, but always uploads
+     * at least one ready model so the queue keeps moving.
+     * Evicts models afterwards if the store is over budget.
+     *
+     * @param budget Time budget for the uploads.
+     */
+    void processUploads(const std::chrono::steady_clock::duration budget);
+
+    /**
+     * @brief Sets the memory budgets and evicts models above them.
+     */
+    void setRetentionPolicy(const RetentionPolicy& policy);
+
+    /**
+     * @brief Returns the registry owning the loaded resources.
+     */
+    [[nodiscard]] ResourceRegistry& getResources() noexcept {
+        return *m_resources;
+    }
+
+    [[nodiscard]] const ResourceRegistry& getResources() const noexcept {
+        return *m_resources;
+    }
+
+    [[nodiscard]] const RetentionPolicy& getRetentionPolicy() const noexcept {
+        return m_retentionPolicy;
+    }
+
+    [[nodiscard]] const Stats& getStats() const noexcept {
+        return m_stats;
+    }
+
+    /**
+     * @brief Returns the number of models still waiting for a worker or an upload.
+     */
+    [[nodiscard]] std::size_t getPendingCount() const noexcept {
+        return m_pendingUploads.size();
+    }
+
 private:
-    using ModelScalesMap = std::unordered_map<float, std::weak_ptr<Model>>;
-    std::unordered_map<std::filesystem::path, ModelScalesMap> m_modelCache{};
+    struct CachedGeometry {
+        GeometryHandle geometry{};
+        std::unordered_map<float, ModelHandle> variants{};
+        std::uint64_t lastUse{};
+        std::size_t cpuByteSize{};
+        std::size_t gpuByteSize{};
+        bool isPinned{};
+    };
+
+    /**
+     * @brief Output of a load job, shared so it outlives a moved or destroyed store.
+     */
+    struct LoadResult {
+        std::unique_ptr<ModelSource> source{};
+        std::exception_ptr error{};
+    };
+
+    struct PendingUpload {
+        GeometryHandle geometry{};
+        JobHandle job{};
+        std::shared_ptr<LoadResult> result{};
+        std::filesystem::path path{};
+    };
+
+    /**
+     * @brief Returns the cached geometry of a model file, loading it on a miss.
+     *
+     * @param path Model file path.
+     * @param async Whether a miss starts an asynchronous load,
+     *        otherwise a pending load is finished right away.
+     * @param isLookup Whether the call counts towards the hit and miss stats,
+     *        pinning is no lookup.
+     *
+     * @throws std::runtime_error If a synchronous load fails.
+     */
+    [[nodiscard]] CachedGeometry& acquire(
+        const std::filesystem::path& path,
+        const bool async,
+        const bool isLookup = true
+    );
+
+    /**
+     * @brief Returns the model of a geometry for a scale, creating it on first use.
+     */
+    [[nodiscard]] ModelHandle getVariant(
+        CachedGeometry& cachedGeometry,
+        const float scale
+    );
+
+    /**
+     * @brief Uploads a finished load, forgetting the geometry if the load failed.
+     *
+     * @throws std::runtime_error If the job failed to load the model
+     *         or the mesh creation fails.
+     */
+    void finishUpload(PendingUpload& pending);
+
+    void updateByteSize(CachedGeometry& cachedGeometry) noexcept;
+    void erase(const std::filesystem::path& path) noexcept;
+    void evictOverBudget();
+
+    [[nodiscard]] bool isEvictable(const CachedGeometry& cachedGeometry) const noexcept;
+
+    JobSystem* m_jobSystem{};
+    std::unique_ptr<ResourceRegistry> m_resources{};
+    std::unordered_map<std::filesystem::path, CachedGeometry> m_geometries{};
+    std::unordered_set<std::filesystem::path> m_evictedPaths{};
+    std::vector<PendingUpload> m_pendingUploads{};
+    std::vector<std::uint32_t> m_modelReferences{};
+
+    RetentionPolicy m_retentionPolicy{};
+    Stats m_stats{};
+    std::uint64_t m_useCounter{};
+    bool m_loadGeometry{ true };
 };
 
 #endif // MODEL_STORE_H
@@ -3,57 +3,123 @@
 #ifndef MODEL_H
 #define MODEL_H
 
-#include "mesh.h"
+#include "resource-handle.h"
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
 #include <vector>
-#include <filesystem>
 
-struct Material;
-struct aiScene;
-struct aiNode;
+class ModelSource;
+class ResourceRegistry;
 
 /**
- * @brief 3D model composed of multiple meshes.
+ * @brief GPU geometry of a model file, composed of multiple meshes.
  *
- * Loads mesh and material data using Assimp.
+ * The meshes, materials and textures live in a ResourceRegistry,
+ * the geometry only records their handles and releases them in
+ * release(). Vertices are kept in the model space of the source file,
+ * so every scale variant of a model can share one geometry.
  */
-class Model {
+class ModelGeometry {
 public:
     /**
-     * @brief Loads a model from disk.
+     * @brief Creates an empty geometry without any meshes.
+     */
+    ModelGeometry() = default;
+
+    /**
+     * @brief Uploads a geometry prepared on the CPU.
      *
-     * @param path Path to the model file.
-     * @param transform Root transform applied to the model.
+     * @param resources Registry receiving the meshes, materials and textures.
+     * @param source Decoded model data.
      *
-     * @throws std::runtime_error If assimp fails to parse the file
-     *         or the mesh creation fails.
+     * @throws std::runtime_error If the mesh creation fails, in which case
+     *         the resources created so far are released.
      */
-    explicit Model(
-        const std::filesystem::path& path,
-        const glm::mat4& transform = { 1.f }
-    );
+    ModelGeometry(ResourceRegistry& resources, const ModelSource& source);
 
-    Model(const Model&) = delete;
-    Model& operator=(const Model&) = delete;
+    ModelGeometry(const ModelGeometry&) = delete;
+    ModelGeometry& operator=(const ModelGeometry&) = delete;
 
-    Model(Model&& other) noexcept = default;
-    Model& operator=(Model&& other) noexcept = default;
+    ModelGeometry(ModelGeometry&& other) noexcept = default;
+    ModelGeometry& operator=(ModelGeometry&& other) noexcept = default;
+
+    /**
+     * @brief Destroys the meshes, materials and textures of the geometry.
+     *
+     * The geometry is empty afterwards.
+     *
+     * @param resources Registry the geometry was uploaded to.
+     */
+    void release(ResourceRegistry& resources) noexcept;
 
-    [[nodiscard]] const std::vector<Mesh>& getMeshes() const noexcept {
+    [[nodiscard]] const std::vector<MeshHandle>& getMeshes() const noexcept {
         return m_meshes;
     }
 
+    /**
+     * @brief Returns the approximate CPU memory held by the geometry, in bytes.
+     */
+    [[nodiscard]] std::size_t getCpuByteSize() const noexcept {
+        return m_cpuByteSize;
+    }
+
+    /**
+     * @brief Returns the approximate GPU memory held by the geometry, in bytes.
+     *
+     * Covers vertex and index buffers and diffuse textures with their mipmaps.
+     */
+    [[nodiscard]] std::size_t getGpuByteSize() const noexcept {
+        return m_gpuByteSize;
+    }
+
+private:
+    std::vector<MeshHandle> m_meshes{};
+    std::vector<MaterialHandle> m_materials{};
+    std::vector<TextureHandle> m_textures{};
+    std::size_t m_cpuByteSize{ sizeof(ModelGeometry) };
+    std::size_t m_gpuByteSize{};
+};
+
+/**
+ * @brief 3D model, a shared geometry placed by a root transform.
+ *
+ * The root transform (typically a uniform scale) is applied per instance
+ * when drawing, instead of being baked into the vertices.
+ */
+class Model {
+public:
+    /**
+     * @brief Creates an empty model without any meshes.
+     */
+    Model() = default;
+
+    /**
+     * @brief Creates a model from a shared geometry.
+     *
+     * @param geometry Geometry of the model.
+     * @param transform Root transform applied to the geometry.
+     */
+    explicit Model(
+        const GeometryHandle geometry,
+        const glm::mat4& transform = { 1.f }
+    ) noexcept
+        : m_geometry{ geometry }
+        , m_transform{ transform }
+    {}
+
+    [[nodiscard]] GeometryHandle getGeometry() const noexcept {
+        return m_geometry;
+    }
+
+    [[nodiscard]] const glm::mat4& getTransform() const noexcept {
+        return m_transform;
+    }
+
 private:
-    void processNode(
-        const aiScene* const scene,
-        const aiNode* const node,
-        const glm::mat4& parentTransform
-    );
-
-    std::vector<Mesh> m_meshes{};
-    std::vector<std::shared_ptr<Material>> m_materials{};
+    GeometryHandle m_geometry{};
+    glm::mat4 m_transform{ 1.f };
 };
 
 #endif // MODEL_H
@@ -0,0 +1,43 @@
+#include "render-queue.h"
+
+#include <algorithm>
+
+std::uint64_t RenderQueue::makeKey(
+    const std::uint32_t shader,
+    const GLuint texture,
+    const std::uint32_t material,
+    const GLuint vao,
+    const float depth
+) noexcept {
+    const auto quantizedDepth{ static_cast<std::uint64_t>(std::clamp(depth, 0.f, 1.f) * 0xFFFF) };
+
+    return (static_cast<std::uint64_t>(shader & 0xF) << 60)
+        | (static_cast<std::uint64_t>(texture & 0xFFFF) << 44)
+        | (static_cast<std::uint64_t>(material & 0xFFF) << 32)
+        | (static_cast<std::uint64_t>(vao & 0xFFFF) << 16)
+        | quantizedDepth;
+}
+
+void RenderQueue::sort() {
+    const std::size_t submissionOrderChanges{ countStateChanges() };
+
+    std::ranges::sort(m_commands, {}, &DrawCommand::key);
+
+    m_stats.stateChanges = countStateChanges();
+    m_stats.stateChangesSaved = submissionOrderChanges - std::min(submissionOrderChanges, m_stats.stateChanges);
+}
+
+std::size_t RenderQueue::countStateChanges() const noexcept {
+    std::size_t stateChanges{};
+    const DrawCommand* previous{};
+
+    for (const auto& command : m_commands) {
+        stateChanges += !previous || previous->shader != command.shader;
+        stateChanges += command.texture && (!previous || previous->texture != command.texture);
+        stateChanges += !previous || previous->material != command.material;
+        stateChanges += !previous || previous->vao != command.vao;
+        previous = &command;
+    }
+
+    return stateChanges;
+}
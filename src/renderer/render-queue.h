@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Mesh;
+struct Material;
+
+/**
+ * @brief Single queued draw call.
+ */
+struct DrawCommand {
+    std::uint64_t key{};           ///< Sort key, see RenderQueue::makeKey()
+    const Mesh* mesh{};            ///< Mesh to draw
+    const Material* material{};    ///< Material of the mesh
+    GLuint texture{};              ///< Diffuse texture, 0 if the material has none
+    GLuint vao{};                  ///< Vertex array of the mesh
+    std::uint32_t shader{};        ///< Index of the shader used for the draw
+    std::uint32_t firstInstance{}; ///< Offset into the instance buffer
+    std::uint32_t instanceCount{}; ///< Number of instances drawn
+};
+
+/**
+ * @brief Queue of draw calls ordered by 64-bit sort keys.
+ *
+ * Keys are built so that sorting groups draws by shader, then texture,
+ * material and vertex array, which minimizes glUseProgram, glBindTexture
+ * and glBindVertexArray calls. Draws sharing all of that state are
+ * ordered front-to-back so that the depth test can reject hidden
+ * fragments early.
+ */
+class RenderQueue {
+public:
+    /**
+     * @brief State changes required to execute the queue.
+     */
+    struct Stats {
+        std::size_t stateChanges{};      ///< Changes needed in the sorted order
+        std::size_t stateChangesSaved{}; ///< Changes avoided compared to the submission order
+    };
+
+    /**
+     * @brief Builds a sort key.
+     *
+     * Layout from the most significant bits:
+     * shader (4), texture (16), material (12), vertex array (16), depth (16).
+     * Fields wider than their slot are truncated, which only affects
+     * the quality of the ordering, never the correctness of the draws.
+     *
+     * @param depth Normalized distance from the camera, in the range [0, 1].
+     */
+    [[nodiscard]] static std::uint64_t makeKey(
+        const std::uint32_t shader,
+        const GLuint texture,
+        const std::uint32_t material,
+        const GLuint vao,
+        const float depth
+    ) noexcept;
+
+    void push(const DrawCommand& command) {
+        m_commands.push_back(command);
+    }
+
+    /**
+     * @brief Sorts the queued commands by key and updates the statistics.
+     */
+    void sort();
+
+    /**
+     * @brief Removes all commands while keeping the allocated memory.
+     */
+    void clear() noexcept {
+        m_commands.clear();
+    }
+
+    [[nodiscard]] std::span<const DrawCommand> getCommands() const noexcept { return m_commands; }
+    [[nodiscard]] const Stats& getStats() const noexcept { return m_stats; }
+
+private:
+    [[nodiscard]] std::size_t countStateChanges() const noexcept;
+
+    std::vector<DrawCommand> m_commands{};
+    Stats m_stats{};
+};
+
+#endif // RENDER_QUEUE_H
@@ -1,55 +1,251 @@
 #include "renderer.h"
 
+#include "gl-call.h"
 #include "material.h"
 #include "lighting.h"
 #include "model.h"
 #include "camera.h"
+#include "resource-registry.h"
+
+#include <core/profiler.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
 Renderer::Renderer() : m_shaders{
     Shader{ "assets/shaders/mesh-lit.vert", "assets/shaders/mesh-lit.frag" }
 } {
+    for (const auto& shader : m_shaders) {
+        shader.bindUniformBlock("Camera", CameraBlockBinding);
+        shader.bindUniformBlock("Lighting", LightingBlockBinding);
+    }
+
+    const Shader& meshLit{ m_shaders[ShaderType::MeshLit] };
+    m_meshLitUniforms = {
+        .diffuse{ meshLit.getUniform<int>("u_material.diffuse") },
+        .specularColor{ meshLit.getUniform<glm::vec3>("u_material.specularColor") },
+        .specularStrength{ meshLit.getUniform<float>("u_material.specularStrength") },
+        .shininess{ meshLit.getUniform<float>("u_material.shininess") },
+    };
+
+    GL_CALL(glGenBuffers(1, &m_instanceVbo));
     glEnable(GL_DEPTH_TEST);
 }
 
-void Renderer::beginFrame(const Lighting& lighting, const Camera& camera) {
+Renderer::~Renderer() {
+    if (m_instanceVbo) {
+        glDeleteBuffers(1, &m_instanceVbo);
+    }
+}
+
+void Renderer::beginFrame(const Lighting& lighting, const Camera& camera, const ResourceRegistry& resources) {
     m_cachedCamera = &camera;
+    m_cachedResources = &resources;
+
+    m_sceneTimer.begin();
 
     glClearColor(0.05f, 0.05f, 0.05f, 1.f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    m_shaders[ShaderType::MeshLit].use();
-    m_shaders[ShaderType::MeshLit].setVec3("u_lighting.ambient", lighting.ambient);
-    m_shaders[ShaderType::MeshLit].setVec3("u_lighting.sunPosition", lighting.sunPosition);
-    m_shaders[ShaderType::MeshLit].setVec3("u_lighting.sunColor", lighting.sunColor);
-    m_shaders[ShaderType::MeshLit].setVec3("u_cameraPos", m_cachedCamera->getPosition());
+    m_cameraBuffer.setData(CameraBlock{
+        .view{ camera.getView() },
+        .projection{ camera.getProjection() },
+        .viewProjection{ camera.getViewProjection() },
+        .position{ camera.getPosition(), 1.f },
+    });
+
+    m_lightingBuffer.setData(LightingBlock{
+        .ambient{ lighting.ambient, 0.f },
+        .sunPosition{ lighting.sunPosition, 1.f },
+        .sunColor{ lighting.sunColor, 0.f },
+    });
 }
 
-void Renderer::endFrame() {}
+void Renderer::endFrame() {
+    PROFILE_ZONE("Renderer::endFrame");
+    m_frameStats = {};
+
+    if (!m_cachedCamera) {
+        return;
+    }
+
+    buildRenderQueue();
+
+    if (!m_instanceData.empty()) {
+        const auto instanceDataSize{ static_cast<GLsizeiptr>(m_instanceData.size() * sizeof(InstanceData)) };
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+        glBufferData(GL_ARRAY_BUFFER, instanceDataSize, NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instanceDataSize, m_instanceData.data());
 
-void Renderer::draw(const Model& object, const glm::mat4& transform) {
+        executeRenderQueue();
+    }
+
+    m_sceneTimer.end();
+
+    m_cachedCamera = nullptr;
+    m_cachedResources = nullptr;
+}
+
+void Renderer::draw(const ModelHandle object, const glm::mat4& transform) {
+    PROFILE_ZONE("Renderer::draw");
     if (!m_cachedCamera) {
         return;
     }
 
-    const glm::mat3 normal{ glm::transpose(glm::inverse(glm::mat3{ transform })) };
+    const Model* const model{ m_cachedResources->get(object) };
+    if (!model) {
+        return;
+    }
+
+    const ModelGeometry* const geometry{ m_cachedResources->get(model->getGeometry()) };
+    if (!geometry || geometry->getMeshes().empty()) {
+        return;
+    }
+
+    // Models sharing a geometry batch together, whatever their root transform.
+    const glm::mat4 modelTransform{ transform * model->getTransform() };
+
+    const std::uint32_t batchIndex{ model->getGeometry().getIndex() };
+    if (batchIndex >= m_instanceBatches.size()) {
+        m_instanceBatches.resize(batchIndex + 1);
+    }
+
+    auto& instances{ m_instanceBatches[batchIndex] };
+    if (instances.empty()) {
+        m_batchedGeometries.push_back(model->getGeometry());
+    }
 
-    m_shaders[ShaderType::MeshLit].setMat3("u_normal", normal);
-    m_shaders[ShaderType::MeshLit].setMat4("u_mvp", m_cachedCamera->getViewProjection() * transform);
+    instances.push_back({
+        .model{ modelTransform },
+        // Without shear or non-uniform scale the inverse transpose only differs by a factor,
+        // which the fragment shader normalizes away.
+        .normal{ glm::mat3{ modelTransform } },
+    });
+}
 
-    for (const auto& mesh : object.getMeshes()) {
-        const auto& material{ *mesh.getMaterial() };
-        if (material.diffuse) {
-            material.diffuse->bind(0);
-            m_shaders[ShaderType::MeshLit].setInt("u_material.diffuse", 0);
+void Renderer::setInstanceAttributes(const std::size_t firstInstance) {
+    constexpr GLuint modelLocation{ 3 };
+    constexpr GLuint normalLocation{ 7 };
+    constexpr GLsizei stride{ sizeof(InstanceData) };
+
+    // Attribute pointers are relative to the instance buffer bound to GL_ARRAY_BUFFER.
+    const std::size_t baseOffset{ firstInstance * sizeof(InstanceData) };
+
+    for (GLuint column{}; column < 4; ++column) {
+        glEnableVertexAttribArray(modelLocation + column);
+        glVertexAttribPointer(modelLocation + column, 4, GL_FLOAT, GL_FALSE, stride,
+            reinterpret_cast<void*>(baseOffset + offsetof(InstanceData, model) + sizeof(glm::vec4) * column));
+        glVertexAttribDivisor(modelLocation + column, 1);
+    }
+
+    for (GLuint column{}; column < 3; ++column) {
+        glEnableVertexAttribArray(normalLocation + column);
+        glVertexAttribPointer(normalLocation + column, 3, GL_FLOAT, GL_FALSE, stride,
+            reinterpret_cast<void*>(baseOffset + offsetof(InstanceData, normal) + sizeof(glm::vec3) * column));
+        glVertexAttribDivisor(normalLocation + column, 1);
+    }
+}
+
+void Renderer::buildRenderQueue() {
+    PROFILE_ZONE("Renderer::buildRenderQueue");
+    const glm::vec3 cameraPosition{ m_cachedCamera->getPosition() };
+    const auto distanceSquared{ [&cameraPosition](const InstanceData& instance) {
+        const glm::vec3 offset{ glm::vec3{ instance.model[3] } - cameraPosition };
+        return glm::dot(offset, offset);
+    } };
+
+    m_renderQueue.clear();
+    m_instanceData.clear();
+
+    for (const GeometryHandle geometryHandle : m_batchedGeometries) {
+        auto& instances{ m_instanceBatches[geometryHandle.getIndex()] };
+        const ModelGeometry* const geometry{ m_cachedResources->get(geometryHandle) };
+        if (!geometry) {
+            instances.clear();
+            continue;
         }
 
-        m_shaders[ShaderType::MeshLit].setVec3("u_material.specularColor", material.specularColor);
-        m_shaders[ShaderType::MeshLit].setFloat("u_material.specularStrength", material.specularStrength);
-        m_shaders[ShaderType::MeshLit].setFloat("u_material.shininess", material.shininess);
+        std::ranges::sort(instances, {}, distanceSquared);
+
+        const float nearestDepth{ std::sqrt(distanceSquared(instances.front())) / m_cachedCamera->getFarPlane() };
+        const auto firstInstance{ static_cast<std::uint32_t>(m_instanceData.size()) };
+        const auto instanceCount{ static_cast<std::uint32_t>(instances.size()) };
+
+        m_instanceData.insert(m_instanceData.end(), instances.begin(), instances.end());
+        instances.clear();
+
+        for (const MeshHandle meshHandle : geometry->getMeshes()) {
+            const Mesh* const mesh{ m_cachedResources->get(meshHandle) };
+            const MaterialHandle materialHandle{ mesh->getMaterial() };
+            const Material* const material{ m_cachedResources->get(materialHandle) };
+            const Texture2D* const diffuse{ m_cachedResources->get(material->diffuse) };
+            const GLuint texture{ diffuse ? diffuse->getId() : 0 };
 
-        glBindVertexArray(mesh.getVao());
-        glDrawElements(GL_TRIANGLES, mesh.getIndexCount(), GL_UNSIGNED_INT, NULL);
+            // Handle indices are dense, so they double as material ids of the sort key.
+            m_renderQueue.push({
+                .key{ RenderQueue::makeKey(ShaderType::MeshLit, texture, materialHandle.getIndex(), mesh->getVao(), nearestDepth) },
+                .mesh{ mesh },
+                .material{ material },
+                .texture{ texture },
+                .vao{ mesh->getVao() },
+                .shader{ ShaderType::MeshLit },
+                .firstInstance{ firstInstance },
+                .instanceCount{ instanceCount },
+            });
+        }
     }
-}
\ No newline at end of file
+
+    m_batchedGeometries.clear();
+    m_renderQueue.sort();
+    m_frameStats.instances = m_instanceData.size();
+}
+
+void Renderer::executeRenderQueue() {
+    PROFILE_ZONE("Renderer::executeRenderQueue");
+    std::optional<std::uint32_t> currentShader{};
+    const Material* currentMaterial{};
+    GLuint currentTexture{};
+    GLuint currentVao{};
+
+    for (const auto& command : m_renderQueue.getCommands()) {
+        const Shader& shader{ m_shaders[command.shader] };
+
+        if (command.shader != currentShader) {
+            shader.use();
+            shader.set(m_meshLitUniforms.diffuse, 0);
+            currentShader = command.shader;
+            currentMaterial = nullptr;
+        }
+
+        // Meshes without a diffuse texture keep whatever texture is bound.
+        if (command.texture && command.texture != currentTexture) {
+            m_cachedResources->get(command.material->diffuse)->bind(0);
+            currentTexture = command.texture;
+        }
+
+        if (command.material != currentMaterial) {
+            shader.set(m_meshLitUniforms.specularColor, command.material->specularColor);
+            shader.set(m_meshLitUniforms.specularStrength, command.material->specularStrength);
+            shader.set(m_meshLitUniforms.shininess, command.material->shininess);
+            currentMaterial = command.material;
+        }
+
+        if (command.vao != currentVao) {
+            glBindVertexArray(command.vao);
+            currentVao = command.vao;
+        }
+
+        setInstanceAttributes(command.firstInstance);
+        glDrawElementsInstanced(GL_TRIANGLES, command.mesh->getIndexCount(), GL_UNSIGNED_INT, NULL, command.instanceCount);
+
+        ++m_frameStats.drawCalls;
+    }
+
+    glBindVertexArray(0);
+
+    m_frameStats.stateChanges = m_renderQueue.getStats().stateChanges;
+    m_frameStats.stateChangesSaved = m_renderQueue.getStats().stateChangesSaved;
+}
@@ -4,12 +4,20 @@
 #define RENDERER_H
 
 #include "shader.h"
+#include "render-queue.h"
+#include "uniform-buffer.h"
+#include "gpu-timer.h"
+#include "resource-handle.h"
 #include <glm/glm.hpp>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 class Camera;
-class Model;
+class ResourceRegistry;
 struct Lighting;
+struct Material;
 
 /** 
  * @brief Responsible for rendering 3D models using OpenGL.
@@ -22,19 +30,50 @@ struct Lighting;
  * Shader programs themselves are managed by the Shader class. The Renderer
  * only owns instances of shaders and uses them during rendering.
  *
- * The active camera is provided at the beginning of each frame via
- * beginFrame() and cached temporarily for draw calls within that frame.
+ * The active camera and the ResourceRegistry owning the drawn models are
+ * provided at the beginning of each frame via beginFrame() and cached
+ * temporarily for draw calls within that frame.
+ *
+ * Draw requests are collected during the frame and grouped by geometry,
+ * in batches indexed by the geometry handle.
+ * They are issued in endFrame() as a single instanced draw call per
+ * mesh of every unique model, with per-instance matrices stored in
+ * a vertex buffer. The draw calls go through a RenderQueue which orders
+ * them to minimize OpenGL state changes.
+ *
+ * Per-frame camera and lighting data live in std140 uniform blocks
+ * which are uploaded once per frame and shared by every shader program.
+ *
+ * The GPU time of the scene pass and of the UI pass, which the caller
+ * brackets with beginUiPass() and endUiPass(), is measured with
+ * GpuTimer queries and reported a few frames late.
  */
 
 class Renderer {
 public:
+    /**
+     * @brief Statistics of the latest finished frame.
+     */
+    struct FrameStats {
+        std::size_t drawCalls{};         ///< Number of issued draw calls
+        std::size_t instances{};         ///< Number of drawn model instances
+        std::size_t stateChanges{};      ///< Number of program, texture, material and vertex array changes
+        std::size_t stateChangesSaved{}; ///< State changes avoided by sorting the draw calls
+    };
+
     /**
      * @brief Constructs the renderer and initializes OpenGL state.
      *
-     * Initializes shader instances and enables depth testing.
+     * Initializes shader instances, the instance and uniform buffers
+     * and enables depth testing.
      */
     Renderer();
 
+    /**
+     * @brief Releases the instance buffer.
+     */
+    ~Renderer();
+
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
 
@@ -44,46 +83,140 @@ public:
     /**
      * @brief Prepares the renderer for a new frame.
      *
-     * Clears frame buffers, activates appropriate shaders and uploads
-     * per-frame data such as lighting parameters and camera position.
-     * The provided camera is expected to remain valid for the duration
-     * of the frame.
+     * Clears frame buffers and uploads per-frame data such as lighting
+     * parameters and camera matrices into the shared uniform buffers.
+     * The provided camera and registry are expected to remain valid
+     * for the duration of the frame.
      *
      * @param lighting Scene lighting data used for the frame.
      * @param camera Camera used to generate view and projection matrices.
+     * @param resources Registry resolving the handles drawn during the frame.
      */
-    void beginFrame(const Lighting& lighting, const Camera& camera);
+    void beginFrame(const Lighting& lighting, const Camera& camera, const ResourceRegistry& resources);
 
     /**
      * @brief Finishes the current frame.
      *
-     * Intended as a synchronization point for frame-based rendering logic.
-     * Currently performs no operations.
+     * Uploads the per-instance data of all models drawn during the frame
+     * and issues one instanced draw call per mesh of every unique model,
+     * in the order given by the render queue. Instances of a model are
+     * drawn front-to-back.
      */
     void endFrame();
 
     /**
-     * @brief Renders a model using the currently active frame state.
+     * @brief Queues a model to be rendered using the currently active frame state.
      *
-     * Uses the camera provided in beginFrame() to compute transformation
-     * matrices and renders all meshes contained in the model using
-     * their associated materials.
+     * The model is rendered in endFrame() together with all other instances
+     * of the same geometry, using the camera provided in beginFrame().
+     * The root transform of the model is applied before the given transform.
+     * Stale handles and models without geometry are skipped.
+     * The transform has to be composed of rotation, translation
+     * and uniform scale, so normals can be transformed by it directly.
      *
      * If beginFrame() has not been called, this function performs no rendering.
      *
-     * @param object Model to be rendered.
+     * @param object Handle of the model to be rendered.
      * @param transform Model transformation matrix.
      */
-    void draw(const Model& object, const glm::mat4& transform);
+    void draw(const ModelHandle object, const glm::mat4& transform);
+
+    /**
+     * @brief Starts measuring the GPU time of the UI draw calls issued by the caller.
+     *
+     * Has to be called outside of beginFrame() and endFrame().
+     */
+    void beginUiPass() noexcept { m_uiTimer.begin(); }
+
+    /**
+     * @brief Stops measuring the GPU time of the UI pass.
+     */
+    void endUiPass() noexcept { m_uiTimer.end(); }
+
+    /**
+     * @brief Returns statistics of the latest finished frame.
+     */
+    [[nodiscard]] const FrameStats& getFrameStats() const noexcept { return m_frameStats; }
+
+    /**
+     * @brief Returns the GPU times of the latest passes whose queries were read back.
+     */
+    [[nodiscard]] GpuFrameTimings getGpuTimings() const noexcept {
+        return { .sceneMs{ m_sceneTimer.getElapsedMs() }, .uiMs{ m_uiTimer.getElapsedMs() } };
+    }
 
 private:
+    /**
+     * @brief Uniform block binding points shared by all shader programs.
+     */
+    enum UniformBlockBinding : GLuint {
+        CameraBlockBinding,
+        LightingBlockBinding,
+    };
+
+    /**
+     * @brief std140 layout of the Camera uniform block.
+     */
+    struct CameraBlock {
+        glm::mat4 view{};
+        glm::mat4 projection{};
+        glm::mat4 viewProjection{};
+        glm::vec4 position{};
+    };
+
+    /**
+     * @brief std140 layout of the Lighting uniform block, vec3 members are padded to vec4.
+     */
+    struct LightingBlock {
+        glm::vec4 ambient{};
+        glm::vec4 sunPosition{};
+        glm::vec4 sunColor{};
+    };
+
+    /**
+     * @brief Uniforms of the MeshLit shader resolved at construction.
+     */
+    struct MeshLitUniforms {
+        UniformHandle<int> diffuse{};
+        UniformHandle<glm::vec3> specularColor{};
+        UniformHandle<float> specularStrength{};
+        UniformHandle<float> shininess{};
+    };
+
+    /**
+     * @brief Per-instance vertex data.
+     */
+    struct InstanceData {
+        glm::mat4 model{};
+        glm::mat3 normal{};
+    };
+
+    static void setInstanceAttributes(const std::size_t firstInstance);
+
+    void buildRenderQueue();
+    void executeRenderQueue();
+
     enum ShaderType {
         MeshLit,
         COUNT
     };
 
     std::array<Shader, ShaderType::COUNT> m_shaders;
+    MeshLitUniforms m_meshLitUniforms{};
+    UniformBuffer m_cameraBuffer{ sizeof(CameraBlock), CameraBlockBinding };
+    UniformBuffer m_lightingBuffer{ sizeof(LightingBlock), LightingBlockBinding };
     const Camera* m_cachedCamera{};
+    const ResourceRegistry* m_cachedResources{};
+
+    /// Instances per geometry, indexed by the geometry handle index.
+    std::vector<std::vector<InstanceData>> m_instanceBatches{};
+    std::vector<GeometryHandle> m_batchedGeometries{};
+    std::vector<InstanceData> m_instanceData{};
+    RenderQueue m_renderQueue{};
+    GLuint m_instanceVbo{};
+    FrameStats m_frameStats{};
+    GpuTimer m_sceneTimer{};
+    GpuTimer m_uiTimer{};
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef RESOURCE_HANDLE_H
+#define RESOURCE_HANDLE_H
+
+#include <cstdint>
+#include <functional>
+
+class Texture2D;
+struct Material;
+class Mesh;
+class ModelGeometry;
+class Model;
+
+/**
+ * @brief Generation-checked 32-bit reference to a pooled renderer resource.
+ *
+ * The low bits index a slot of a ResourcePool, the high bits hold the
+ * generation of the slot at the time the handle was issued. Once the
+ * resource is destroyed the slot generation changes, so stale handles
+ * resolve to nothing instead of to whatever reuses the slot.
+ *
+ * @tparam T Resource type, only used to keep handles of different pools apart.
+ */
+template <typename T>
+class ResourceHandle {
+public:
+    static constexpr std::uint32_t indexBits{ 20 };
+    static constexpr std::uint32_t generationBits{ 32 - indexBits };
+    static constexpr std::uint32_t indexMask{ (1u << indexBits) - 1 };
+    static constexpr std::uint32_t generationMask{ (1u << generationBits) - 1 };
+
+    /// Largest index a pool may hand out, the all-ones index is reserved for invalid handles.
+    static constexpr std::uint32_t maxIndex{ indexMask - 1 };
+
+    /**
+     * @brief Creates an invalid handle.
+     */
+    constexpr ResourceHandle() noexcept = default;
+
+    constexpr ResourceHandle(const std::uint32_t index, const std::uint32_t generation) noexcept
+        : m_value{ (index & indexMask) | ((generation & generationMask) << indexBits) }
+    {}
+
+    [[nodiscard]] constexpr std::uint32_t getIndex() const noexcept { return m_value & indexMask; }
+    [[nodiscard]] constexpr std::uint32_t getGeneration() const noexcept { return m_value >> indexBits; }
+    [[nodiscard]] constexpr std::uint32_t getValue() const noexcept { return m_value; }
+    [[nodiscard]] constexpr bool isValid() const noexcept { return getIndex() != indexMask; }
+
+    [[nodiscard]] constexpr bool operator==(const ResourceHandle&) const noexcept = default;
+
+private:
+    std::uint32_t m_value{ indexMask };
+};
+
+using TextureHandle = ResourceHandle<Texture2D>;
+using MaterialHandle = ResourceHandle<Material>;
+using MeshHandle = ResourceHandle<Mesh>;
+using GeometryHandle = ResourceHandle<ModelGeometry>;
+using ModelHandle = ResourceHandle<Model>;
+
+template <typename T>
+struct std::hash<ResourceHandle<T>> {
+    [[nodiscard]] std::size_t operator()(const ResourceHandle<T> handle) const noexcept {
+        return std::hash<std::uint32_t>{}(handle.getValue());
+    }
+};
+
+#endif // RESOURCE_HANDLE_H
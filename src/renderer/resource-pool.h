@@ -0,0 +1,134 @@
+#pragma once
+
+#ifndef RESOURCE_POOL_H
+#define RESOURCE_POOL_H
+
+#include "resource-handle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Contiguous slot array owning resources of a single type.
+ *
+ * Resources are addressed by ResourceHandle, resolving a handle is
+ * a bounds check, a generation check and a plain array index.
+ * Freed slots are reused, with a new generation.
+ *
+ * Pointers returned by get() are invalidated by emplace().
+ *
+ * @tparam T Resource type.
+ */
+template <typename T>
+class ResourcePool {
+public:
+    using Handle = ResourceHandle<T>;
+
+    /**
+     * @brief Constructs a resource in a free slot.
+     *
+     * @throws std::runtime_error If the pool ran out of handle indices.
+     *
+     * @return Handle of the new resource.
+     */
+    template <typename... Args>
+    Handle emplace(Args&&... args) {
+        std::uint32_t index{};
+        if (m_freeIndices.empty()) {
+            if (m_slots.size() > Handle::maxIndex) {
+                throw std::runtime_error{ std::format("Resource pool is full ({} slots)", m_slots.size()) };
+            }
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        } else {
+            index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        }
+
+        Slot& slot{ m_slots[index] };
+        slot.item.emplace(std::forward<Args>(args)...);
+        ++m_size;
+
+        return { index, slot.generation };
+    }
+
+    /**
+     * @brief Destroys a resource and retires its handle.
+     *
+     * @return False if the handle was already stale.
+     */
+    bool erase(const Handle handle) noexcept {
+        Slot* const slot{ findSlot(handle) };
+        if (!slot) {
+            return false;
+        }
+
+        slot->item.reset();
+        slot->generation = (slot->generation + 1) & Handle::generationMask;
+        m_freeIndices.push_back(handle.getIndex());
+        --m_size;
+
+        return true;
+    }
+
+    /**
+     * @brief Resolves a handle.
+     *
+     * @return Pointer to the resource, or nullptr if the handle is stale or invalid.
+     */
+    [[nodiscard]] T* get(const Handle handle) noexcept {
+        Slot* const slot{ findSlot(handle) };
+        return slot ? &*slot->item : nullptr;
+    }
+
+    [[nodiscard]] const T* get(const Handle handle) const noexcept {
+        return const_cast<ResourcePool*>(this)->get(handle);
+    }
+
+    /**
+     * @brief Returns the number of live resources.
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    /**
+     * @brief Returns the number of slots, live or free.
+     *
+     * Handle indices are always lower than this value.
+     */
+    [[nodiscard]] std::size_t getSlotCount() const noexcept {
+        return m_slots.size();
+    }
+
+private:
+    struct Slot {
+        std::optional<T> item{};
+        std::uint32_t generation{};
+    };
+
+    [[nodiscard]] Slot* findSlot(const Handle handle) noexcept {
+        const std::uint32_t index{ handle.getIndex() };
+        if (index >= m_slots.size()) {
+            return nullptr;
+        }
+
+        Slot& slot{ m_slots[index] };
+        if (slot.generation != handle.getGeneration() || !slot.item) {
+            return nullptr;
+        }
+
+        return &slot;
+    }
+
+    std::vector<Slot> m_slots{};
+    std::vector<std::uint32_t> m_freeIndices{};
+    std::size_t m_size{};
+};
+
+#endif // RESOURCE_POOL_H
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef RESOURCE_REGISTRY_H
+#define RESOURCE_REGISTRY_H
+
+#include "resource-pool.h"
+#include "texture2d.h"
+#include "material.h"
+#include "mesh.h"
+#include "model.h"
+
+#include <tuple>
+#include <utility>
+
+/**
+ * @brief Owner of every renderer resource, one ResourcePool per type.
+ *
+ * Everything outside of the registry refers to textures, materials,
+ * meshes, geometries and models through ResourceHandle values, which
+ * are trivially copyable and resolve with a plain array index.
+ */
+class ResourceRegistry {
+public:
+    ResourceRegistry() = default;
+
+    ResourceRegistry(const ResourceRegistry&) = delete;
+    ResourceRegistry& operator=(const ResourceRegistry&) = delete;
+
+    ResourceRegistry(ResourceRegistry&&) noexcept = default;
+    ResourceRegistry& operator=(ResourceRegistry&&) noexcept = default;
+
+    /**
+     * @brief Constructs a resource.
+     *
+     * @throws std::runtime_error If the resource creation fails
+     *         or its pool is full.
+     */
+    template <typename T, typename... Args>
+    ResourceHandle<T> emplace(Args&&... args) {
+        return getPool<T>().emplace(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Resolves a handle.
+     *
+     * @return Pointer to the resource, or nullptr if the handle is stale or invalid.
+     */
+    template <typename T>
+    [[nodiscard]] T* get(const ResourceHandle<T> handle) noexcept {
+        return getPool<T>().get(handle);
+    }
+
+    template <typename T>
+    [[nodiscard]] const T* get(const ResourceHandle<T> handle) const noexcept {
+        return getPool<T>().get(handle);
+    }
+
+    /**
+     * @brief Destroys a single resource, without the resources it refers to.
+     *
+     * @return False if the handle was already stale.
+     */
+    template <typename T>
+    bool erase(const ResourceHandle<T> handle) noexcept {
+        return getPool<T>().erase(handle);
+    }
+
+    /**
+     * @brief Destroys a geometry together with its meshes, materials and textures.
+     *
+     * Models referring to the geometry are left in place and draw nothing.
+     */
+    void destroyGeometry(const GeometryHandle handle) noexcept {
+        if (ModelGeometry* const geometry{ get(handle) }) {
+            geometry->release(*this);
+            erase(handle);
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] ResourcePool<T>& getPool() noexcept {
+        return std::get<ResourcePool<T>>(m_pools);
+    }
+
+    template <typename T>
+    [[nodiscard]] const ResourcePool<T>& getPool() const noexcept {
+        return std::get<ResourcePool<T>>(m_pools);
+    }
+
+private:
+    std::tuple<
+        ResourcePool<Texture2D>,
+        ResourcePool<Material>,
+        ResourcePool<Mesh>,
+        ResourcePool<ModelGeometry>,
+        ResourcePool<Model>
+    > m_pools{};
+};
+
+#endif // RESOURCE_REGISTRY_H
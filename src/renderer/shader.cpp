@@ -2,6 +2,9 @@
 
 #include "gl-call.h"
 
+#include <core/profiler.h>
+
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <utility>
@@ -13,6 +16,7 @@ Shader::Shader(
         : m_vertexShaderPath  { vertexShaderPath }
         , m_fragmentShaderPath{ fragmentShaderPath }
         , m_geometryShaderPath{ geometryShaderPath } {
+    PROFILE_ZONE("Shader::compile");
     try {
         createShaderProgram();
     } catch (...) {
@@ -26,7 +30,7 @@ Shader::Shader(Shader&& other) noexcept
     , m_vertexShaderPath  { std::move(other.m_vertexShaderPath) }
     , m_fragmentShaderPath{ std::move(other.m_fragmentShaderPath) }
     , m_geometryShaderPath{ std::move(other.m_geometryShaderPath) }
-    , m_uniformLocations  { std::move(other.m_uniformLocations) }
+    , m_uniforms          { std::move(other.m_uniforms) }
 {}
 
 Shader& Shader::operator=(Shader&& other) noexcept {
@@ -40,14 +44,78 @@ Shader& Shader::operator=(Shader&& other) noexcept {
     m_vertexShaderPath   = std::move(other.m_vertexShaderPath);
     m_fragmentShaderPath = std::move(other.m_fragmentShaderPath);
     m_geometryShaderPath = std::move(other.m_geometryShaderPath);
-    m_uniformLocations   = std::move(other.m_uniformLocations);
+    m_uniforms           = std::move(other.m_uniforms);
 
     return *this;
 }
 
-GLint Shader::getUniformLocation(const GLchar* const name) {
-    auto [it, wasInserted]{ m_uniformLocations.try_emplace(name, 0) };
-    return !wasInserted ? it->second : (it->second = glGetUniformLocation(m_shaderProgramId, name));
+GLint Shader::getUniformLocation(const std::uint32_t nameHash) const noexcept {
+    const ReflectedUniform* const uniform{ findUniform(nameHash) };
+    return uniform ? uniform->location : -1;
+}
+
+const Shader::ReflectedUniform* Shader::findUniform(const std::uint32_t nameHash) const noexcept {
+    const auto it{ std::ranges::lower_bound(m_uniforms, nameHash, {}, &ReflectedUniform::nameHash) };
+    return it != m_uniforms.end() && it->nameHash == nameHash ? &*it : nullptr;
+}
+
+const Shader::ReflectedUniform* Shader::findUniform(const std::string_view name) const noexcept {
+    const ReflectedUniform* const uniform{ findUniform(hashUniformName(name)) };
+    return uniform && uniform->name == name ? uniform : nullptr;
+}
+
+void Shader::throwUniformTypeMismatch(const std::string_view name) {
+    throw std::runtime_error{ std::format(R"(Uniform "{}" is accessed with a mismatched type)", name) };
+}
+
+void Shader::reflectUniforms() {
+    m_uniforms.clear();
+
+    GLint uniformCount{};
+    GLint maxNameLength{};
+    glGetProgramiv(m_shaderProgramId, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(m_shaderProgramId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    GLCharString name{};
+    name.resize(maxNameLength);
+
+    for (GLint i{}; i < uniformCount; ++i) {
+        GLsizei nameLength{};
+        GLint size{};
+        GLenum type{};
+        glGetActiveUniform(m_shaderProgramId, i, maxNameLength, &nameLength, &size, &type, name.data());
+
+        // Members of uniform blocks have no location.
+        const GLint location{ glGetUniformLocation(m_shaderProgramId, name.c_str()) };
+        if (location < 0) {
+            continue;
+        }
+
+        std::string_view nameView{ name.data(), static_cast<std::size_t>(nameLength) };
+        m_uniforms.push_back({ hashUniformName(nameView), location, type, std::string{ nameView } });
+
+        // Arrays are reported as "name[0]", make them accessible as "name" as well.
+        if (nameView.ends_with("[0]")) {
+            nameView.remove_suffix(3);
+            m_uniforms.push_back({ hashUniformName(nameView), location, type, std::string{ nameView } });
+        }
+    }
+
+    std::ranges::sort(m_uniforms, {}, &ReflectedUniform::nameHash);
+
+    const auto collision{ std::ranges::adjacent_find(m_uniforms, {}, &ReflectedUniform::nameHash) };
+    if (collision != m_uniforms.end()) {
+        throw std::runtime_error{ std::format(
+            R"(Uniforms "{}" and "{}" share the same name hash)", collision->name, std::next(collision)->name
+        ) };
+    }
+}
+
+void Shader::bindUniformBlock(const GLchar* const blockName, const GLuint bindingPoint) const noexcept {
+    const GLuint blockIndex{ glGetUniformBlockIndex(m_shaderProgramId, blockName) };
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_shaderProgramId, blockIndex, bindingPoint);
+    }
 }
 
 GLuint Shader::createShaderFromFile(const GLenum type, const std::filesystem::path& fileName) {
@@ -124,6 +192,7 @@ void Shader::createShaderProgram() {
     GLint success{};
     glGetProgramiv(m_shaderProgramId, GL_LINK_STATUS, &success);
     if (success) {
+        reflectUniforms();
         return;
     }
 
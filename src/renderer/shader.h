@@ -6,15 +6,112 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <filesystem>
-#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief FNV-1a hash of a uniform name.
+ *
+ * Usable at compile time, e.g. to look up uniforms by a precomputed hash.
+ */
+[[nodiscard]] constexpr std::uint32_t hashUniformName(const std::string_view name) noexcept {
+    std::uint32_t hash{ 2166136261u };
+    for (const char character : name) {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Pre-resolved location of a uniform of type T.
+ *
+ * Obtained from Shader::getUniform(), setting a value through it
+ * performs no lookups. Invalid handles are silently ignored by OpenGL.
+ */
+template <typename T>
+struct UniformHandle {
+    GLint location{ -1 };
+
+    [[nodiscard]] bool isValid() const noexcept { return location >= 0; }
+};
+
+namespace gl::detail {
+
+template <typename T>
+struct UniformTraits;
+
+template <>
+struct UniformTraits<bool> {
+    static bool accepts(const GLenum type) noexcept { return type == GL_BOOL || type == GL_INT; }
+    static void set(const GLint location, const bool value) noexcept { glUniform1i(location, static_cast<int>(value)); }
+};
+
+template <>
+struct UniformTraits<int> {
+    static bool accepts(const GLenum type) noexcept {
+        return type == GL_INT || type == GL_BOOL || type == GL_SAMPLER_2D || type == GL_SAMPLER_CUBE;
+    }
+    static void set(const GLint location, const int value) noexcept { glUniform1i(location, value); }
+};
+
+template <>
+struct UniformTraits<float> {
+    static bool accepts(const GLenum type) noexcept { return type == GL_FLOAT; }
+    static void set(const GLint location, const float value) noexcept { glUniform1f(location, value); }
+};
+
+template <>
+struct UniformTraits<glm::vec2> {
+    static bool accepts(const GLenum type) noexcept { return type == GL_FLOAT_VEC2; }
+    static void set(const GLint location, const glm::vec2& value) noexcept { glUniform2fv(location, 1, &value[0]); }
+};
+
+template <>
+struct UniformTraits<glm::vec3> {
+    static bool accepts(const GLenum type) noexcept { return type == GL_FLOAT_VEC3; }
+    static void set(const GLint location, const glm::vec3& value) noexcept { glUniform3fv(location, 1, &value[0]); }
+};
+
+template <>
+struct UniformTraits<glm::vec4> {
+    static bool accepts(const GLenum type) noexcept { return type == GL_FLOAT_VEC4; }
+    static void set(const GLint location, const glm::vec4& value) noexcept { glUniform4fv(location, 1, &value[0]); }
+};
+
+template <>
+struct UniformTraits<glm::mat2> {
+    static bool accepts(const GLenum type) noexcept { return type == GL_FLOAT_MAT2; }
+    static void set(const GLint location, const glm::mat2& value) noexcept { glUniformMatrix2fv(location, 1, GL_FALSE, &value[0][0]); }
+};
+
+template <>
+struct UniformTraits<glm::mat3> {
+    static bool accepts(const GLenum type) noexcept { return type == GL_FLOAT_MAT3; }
+    static void set(const GLint location, const glm::mat3& value) noexcept { glUniformMatrix3fv(location, 1, GL_FALSE, &value[0][0]); }
+};
+
+template <>
+struct UniformTraits<glm::mat4> {
+    static bool accepts(const GLenum type) noexcept { return type == GL_FLOAT_MAT4; }
+    static void set(const GLint location, const glm::mat4& value) noexcept { glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]); }
+};
+
+} // gl::detail
 
 /**
  * @brief OpenGL shader program wrapper.
  *
- * Compiles, links and manages a shader program
- * and uniform access.
+ * Compiles, links and manages a shader program and uniform access.
+ *
+ * Active uniforms are enumerated once after linking and stored in a table
+ * sorted by name hash. Lookups by name compare the stored name as well, so
+ * a name that is not in the program never resolves to a colliding uniform.
+ * Uniforms can be resolved into typed handles ahead of time, so that setting
+ * them on hot paths does no hashing or allocation.
  */
 class Shader {
 public:
@@ -60,69 +157,132 @@ public:
     }
 
     /**
-     * @brief Returns cached uniform location for a given name.
+     * @brief Returns the location of an active uniform, -1 if there is no such uniform.
      */
-    [[nodiscard]] GLint getUniformLocation(const GLchar* const name);
+    [[nodiscard]] GLint getUniformLocation(const std::string_view name) const noexcept {
+        const ReflectedUniform* const uniform{ findUniform(name) };
+        return uniform ? uniform->location : -1;
+    }
+
+    /**
+     * @brief Returns the location of an active uniform by its name hash, see hashUniformName().
+     *
+     * Linking fails if two active uniforms share a hash, but the name itself
+     * is not verified: the hash of a name that is not in the program may
+     * still match an active uniform. Prefer the name overload outside hot paths.
+     */
+    [[nodiscard]] GLint getUniformLocation(const std::uint32_t nameHash) const noexcept;
+
+    /**
+     * @brief Resolves a typed handle to an active uniform.
+     *
+     * Returns an invalid handle if the program has no such uniform.
+     *
+     * @throws std::runtime_error If the uniform type does not match T.
+     */
+    template <typename T>
+    [[nodiscard]] UniformHandle<T> getUniform(const std::string_view name) const {
+        const ReflectedUniform* const uniform{ findUniform(name) };
+        if (!uniform) {
+            return {};
+        }
+
+        if (!gl::detail::UniformTraits<T>::accepts(uniform->type)) {
+            throwUniformTypeMismatch(name);
+        }
 
-    void setBool(const GLchar* const name, const bool value) {
+        return { uniform->location };
+    }
+
+    /**
+     * @brief Sets a uniform through a pre-resolved handle, the program has to be in use.
+     */
+    template <typename T>
+    void set(const UniformHandle<T> handle, const T& value) const noexcept {
+        gl::detail::UniformTraits<T>::set(handle.location, value);
+    }
+
+    /**
+     * @brief Attaches a uniform block of the program to a binding point.
+     *
+     * Does nothing if the program has no active block with the given name.
+     */
+    void bindUniformBlock(const GLchar* const blockName, const GLuint bindingPoint) const noexcept;
+
+    void setBool(const std::string_view name, const bool value) {
         glUniform1i(getUniformLocation(name), static_cast<int>(value));
     }
 
-    void setInt(const GLchar* const name, const int value) {
+    void setInt(const std::string_view name, const int value) {
         glUniform1i(getUniformLocation(name), value);
     }
 
-    void setFloat(const GLchar* const name, const float value) {
+    void setFloat(const std::string_view name, const float value) {
         glUniform1f(getUniformLocation(name), value);
     }
 
-    void setVec2(const GLchar* const name, const glm::vec2& value) {
+    void setVec2(const std::string_view name, const glm::vec2& value) {
         glUniform2fv(getUniformLocation(name), 1, &value[0]);
     }
 
-    void setVec2(const GLchar* const name, const float x, const float y) {
+    void setVec2(const std::string_view name, const float x, const float y) {
         glUniform2f(getUniformLocation(name), x, y);
     }
 
-    void setVec3(const GLchar* const name, const glm::vec3& value) {
+    void setVec3(const std::string_view name, const glm::vec3& value) {
         glUniform3fv(getUniformLocation(name), 1, &value[0]);
     }
 
-    void setVec3(const GLchar* const name, const float x, const float y, const float z) {
+    void setVec3(const std::string_view name, const float x, const float y, const float z) {
         glUniform3f(getUniformLocation(name), x, y, z);
     }
 
-    void setVec4(const GLchar* const name, const glm::vec4& value) {
+    void setVec4(const std::string_view name, const glm::vec4& value) {
         glUniform4fv(getUniformLocation(name), 1, &value[0]);
     }
 
-    void setVec4(const GLchar* const name, const float x, const float y, const float z, const float w) {
+    void setVec4(const std::string_view name, const float x, const float y, const float z, const float w) {
         glUniform4f(getUniformLocation(name), x, y, z, w);
     }
 
-    void setMat2(const GLchar* const name, const glm::mat2& mat) {
+    void setMat2(const std::string_view name, const glm::mat2& mat) {
         glUniformMatrix2fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
     }
 
-    void setMat3(const GLchar* const name, const glm::mat3& mat) {
+    void setMat3(const std::string_view name, const glm::mat3& mat) {
         glUniformMatrix3fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
     }
 
-    void setMat4(const GLchar* const name, const glm::mat4& mat) {
+    void setMat4(const std::string_view name, const glm::mat4& mat) {
         glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
     }
 
 private:
+    /**
+     * @brief Active uniform enumerated after linking.
+     */
+    struct ReflectedUniform {
+        std::uint32_t nameHash{};
+        GLint location{ -1 };
+        GLenum type{};
+        std::string name{};
+    };
+
     GLuint createShaderFromFile(const GLenum type, const std::filesystem::path& fileName);
 
     void deleteShaderProgram() noexcept;
     void createShaderProgram();
+    void reflectUniforms();
+
+    [[nodiscard]] const ReflectedUniform* findUniform(const std::uint32_t nameHash) const noexcept;
+    [[nodiscard]] const ReflectedUniform* findUniform(const std::string_view name) const noexcept;
+    [[noreturn]] static void throwUniformTypeMismatch(const std::string_view name);
 
     GLuint m_shaderProgramId{};
     std::filesystem::path m_vertexShaderPath{};
     std::filesystem::path m_fragmentShaderPath{};
     std::filesystem::path m_geometryShaderPath{};
-    std::unordered_map<GLCharString, GLint> m_uniformLocations{};
+    std::vector<ReflectedUniform> m_uniforms{};
 };
 
 #endif // SHADER_H
@@ -1,53 +1,30 @@
 #include "texture2d.h"
 
 #include "gl-call.h"
+#include "image.h"
 
-#include <stb_image.h>
-#include <assimp/texture.h>
+#include <core/profiler.h>
 
 #include <utility>
 
-Texture2D::Texture2D(const std::filesystem::path& path) {
-    stbi_set_flip_vertically_on_load(true);
-
-    unsigned char* data{ stbi_load(path.string().c_str(), &m_width, &m_height, &m_nChannels, 0) };
-    if (!data) {
-        throw std::runtime_error{ std::format("Failed to load texture: {}", path.generic_string()) };
-    }
-
-    try {
-        createTextureFromData(data);
-    } catch (...) {
-        deleteTexture();
-        stbi_image_free(data);
-        throw;
-    }
-
-    stbi_image_free(data);
-}
+Texture2D::Texture2D(const std::filesystem::path& path)
+    : Texture2D{ Image{ path } }
+{}
 
-Texture2D::Texture2D(const aiTexture& texture) {
-    unsigned char* data{ stbi_load_from_memory(
-        reinterpret_cast<stbi_uc*>(texture.pcData),
-        texture.mWidth,
-        &m_width,
-        &m_height,
-        &m_nChannels,
-        0
-    ) };
-    if (!data) {
-        throw std::runtime_error{ std::format("Failed to load assimp texture: {}", texture.mFilename.C_Str()) };
-    }
+Texture2D::Texture2D(const std::span<const unsigned char> encodedData)
+    : Texture2D{ Image{ encodedData } }
+{}
 
+Texture2D::Texture2D(const Image& image)
+        : m_width{ image.getWidth() }
+        , m_height{ image.getHeight() }
+        , m_nChannels{ image.getChannelCount() } {
     try {
-        createTextureFromData(data);
+        createTextureFromData(image.getData());
     } catch (...) {
         deleteTexture();
-        stbi_image_free(data);
         throw;
     }
-
-    stbi_image_free(data);
 }
 
 Texture2D::Texture2D(Texture2D&& other) noexcept
@@ -78,6 +55,7 @@ void Texture2D::bind(const unsigned int slotId) const noexcept {
 }
 
 void Texture2D::createTextureFromData(const unsigned char* const data) {
+    PROFILE_ZONE("Texture2D::upload");
     deleteTexture();
 
     GLint internalFormat{};
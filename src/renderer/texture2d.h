@@ -6,8 +6,9 @@
 #include <glad/glad.h>
 
 #include <filesystem>
+#include <span>
 
-struct aiTexture;
+class Image;
 
 /**
  * @brief 2D texture wrapper.
@@ -24,11 +25,20 @@ public:
     explicit Texture2D(const std::filesystem::path& path);
 
     /**
-     * @brief Creates a texture from Assimp data.
+     * @brief Decodes a texture from an encoded image in memory.
+     *
+     * @param encodedData Image file contents (PNG, JPEG, ...).
+     *
+     * @throws std::runtime_error If texture creation fails.
+     */
+    explicit Texture2D(const std::span<const unsigned char> encodedData);
+
+    /**
+     * @brief Uploads an already decoded image.
      *
      * @throws std::runtime_error If texture creation fails.
      */
-    explicit Texture2D(const aiTexture& texture);
+    explicit Texture2D(const Image& image);
 
     /**
      * @brief Destroys the texture.
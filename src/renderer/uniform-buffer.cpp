@@ -0,0 +1,54 @@
+#include "uniform-buffer.h"
+
+#include "gl-call.h"
+
+#include <algorithm>
+#include <utility>
+
+UniformBuffer::UniformBuffer(const std::size_t size, const GLuint bindingPoint)
+        : m_bindingPoint{ bindingPoint }
+        , m_size{ size } {
+    try {
+        GL_CALL(glGenBuffers(1, &m_bufferId));
+        GL_CALL(glBindBuffer(GL_UNIFORM_BUFFER, m_bufferId));
+        GL_CALL(glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(m_size), NULL, GL_DYNAMIC_DRAW));
+        GL_CALL(glBindBufferBase(GL_UNIFORM_BUFFER, m_bindingPoint, m_bufferId));
+        GL_CALL(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    } catch (...) {
+        deleteBuffer();
+        throw;
+    }
+}
+
+UniformBuffer::UniformBuffer(UniformBuffer&& other) noexcept
+    : m_bufferId    { std::exchange(other.m_bufferId, 0) }
+    , m_bindingPoint{ std::exchange(other.m_bindingPoint, 0) }
+    , m_size        { std::exchange(other.m_size, 0) }
+{}
+
+UniformBuffer& UniformBuffer::operator=(UniformBuffer&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    deleteBuffer();
+
+    m_bufferId     = std::exchange(other.m_bufferId, 0);
+    m_bindingPoint = std::exchange(other.m_bindingPoint, 0);
+    m_size         = std::exchange(other.m_size, 0);
+
+    return *this;
+}
+
+void UniformBuffer::setData(const void* const data, const std::size_t size) const noexcept {
+    glBindBuffer(GL_UNIFORM_BUFFER, m_bufferId);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(std::min(size, m_size)), data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBuffer::deleteBuffer() noexcept {
+    if (m_bufferId) {
+        glDeleteBuffers(1, &m_bufferId);
+        m_bufferId = 0;
+    }
+}
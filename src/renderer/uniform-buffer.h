@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef UNIFORM_BUFFER_H
+#define UNIFORM_BUFFER_H
+
+#include <glad/glad.h>
+
+#include <cstddef>
+
+/**
+ * @brief OpenGL uniform buffer object wrapper.
+ *
+ * Owns a buffer attached to a fixed uniform block binding point,
+ * which lets every shader program with a matching block read the
+ * same data without per-program uploads.
+ */
+class UniformBuffer {
+public:
+    /**
+     * @brief Creates the buffer and attaches it to a binding point.
+     *
+     * @param size Size of the buffer in bytes.
+     * @param bindingPoint Uniform block binding point.
+     *
+     * @throws std::runtime_error If buffer creation fails.
+     */
+    UniformBuffer(const std::size_t size, const GLuint bindingPoint);
+
+    /**
+     * @brief Destroys the buffer.
+     */
+    ~UniformBuffer() {
+        deleteBuffer();
+    }
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    UniformBuffer(UniformBuffer&& other) noexcept;
+    UniformBuffer& operator=(UniformBuffer&& other) noexcept;
+
+    /**
+     * @brief Uploads a whole std140 block.
+     *
+     * @tparam T Block type, its layout has to match the std140 rules
+     *         and its size the size of the buffer.
+     */
+    template <typename T>
+    void setData(const T& block) const noexcept {
+        setData(&block, sizeof(T));
+    }
+
+    /**
+     * @brief Uploads raw data at the beginning of the buffer.
+     */
+    void setData(const void* const data, const std::size_t size) const noexcept;
+
+    [[nodiscard]] GLuint getId() const noexcept { return m_bufferId; }
+    [[nodiscard]] GLuint getBindingPoint() const noexcept { return m_bindingPoint; }
+
+private:
+    void deleteBuffer() noexcept;
+
+    GLuint m_bufferId{};
+    GLuint m_bindingPoint{};
+    std::size_t m_size{};
+};
+
+#endif // UNIFORM_BUFFER_H
@@ -1,6 +1,6 @@
 #include "game-over-screen.h"
 
-#include <ecs/queries.h>
+#include <ecs/render-snapshot.h>
 #include <gameplay/game.h>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
@@ -41,7 +41,7 @@ void ui::drawGameOverScreen(Game& game) {
     ImGui::PopFont();
     ImGui::PushFont(NULL, 20.f);
 
-    const Stats playerStats{ getPlayerStats(game.getRegistry()) };
+    const Stats playerStats{ game.getSnapshot().playerStats };
     const auto formattedStats{ std::array{
         std::format("Lost health: {}", playerStats.lostHealth),
         std::format("Bullets fired: {}", playerStats.firedBullets),
@@ -1,15 +1,141 @@
 #include "hud.h"
 
-#include <ecs/queries.h>
+#include <ecs/render-snapshot.h>
 #include <ecs/components.h>
 #include <gameplay/game.h>
+#include <core/allocation-tracker.h>
+#include <core/fps-counter.h>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <format>
+#include <span>
+#include <utility>
+
+using HudText = std::array<char, 128>;
+
+/**
+ * @brief Formats into a fixed buffer, so drawing the HUD does not allocate every frame.
+ */
+template <typename... Args>
+static const char* formatText(HudText& text, const std::format_string<Args...> format, Args&&... args) {
+    const auto result{ std::format_to_n(text.data(), text.size() - 1, format, std::forward<Args>(args)...) };
+    *result.out = '\0';
+    return text.data();
+}
+
+/**
+ * @brief Draws a line of text right-aligned to a point and moves the point below it.
+ */
+static void drawRightAligned(const char* const text, const ImU32 color, ImVec2& topRight, ImDrawList* const drawList) {
+    const ImVec2 textSize{ ImGui::CalcTextSize(text) };
+    drawList->AddText({ topRight.x - textSize.x, topRight.y }, color, text);
+    topRight.y += textSize.y;
+}
+
+/**
+ * @brief Draws the FPS, the CPU and GPU frame times, the frame-time percentiles
+ *        and a frame-time graph right-aligned below a point, and moves the point below them.
+ */
+static void drawFrameTimes(
+    const FpsCounter& fpsCounter,
+    const GpuFrameTimings& gpuTimings,
+    ImVec2& topRight,
+    ImDrawList* const drawList
+) {
+    constexpr ImVec2 graphSize{ 200.f, 50.f };
+    // Frame times above the scale are clipped to the top of the graph.
+    constexpr float graphScaleMs{ 50.f };
+    constexpr float targetFrameTimeMs{ 1000.f / 60.f };
+    constexpr float spacing{ 4.f };
+
+    const FpsCounter::FrameTimeStats& stats{ fpsCounter.getFrameTimeStats() };
+    HudText text{};
+
+    drawRightAligned(formatText(text, "{:.2f} FPS, 1% low {:.2f}", fpsCounter.getFps(), stats.onePercentLowFps),
+        IM_COL32_WHITE, topRight, drawList);
+    drawRightAligned(formatText(text, "CPU {:.2f} ms, GPU {:.2f} ms (UI {:.2f} ms)",
+        fpsCounter.getLatestFrameTime(), gpuTimings.sceneMs + gpuTimings.uiMs, gpuTimings.uiMs),
+        IM_COL32_WHITE, topRight, drawList);
+    drawRightAligned(formatText(text, "p50 {:.2f} ms, p95 {:.2f} ms", stats.p50, stats.p95),
+        IM_COL32_WHITE, topRight, drawList);
+    drawRightAligned(formatText(text, "p99 {:.2f} ms, max {:.2f} ms", stats.p99, stats.max),
+        IM_COL32_WHITE, topRight, drawList);
+
+    const ImVec2 graphTopLeft{ topRight.x - graphSize.x, topRight.y + spacing };
+    const ImVec2 graphBottomRight{ graphTopLeft + graphSize };
+    drawList->AddRectFilled(graphTopLeft, graphBottomRight, IM_COL32(0, 0, 0, 127));
+
+    const std::span<const float> frameTimes{ fpsCounter.getFrameTimes() };
+    const std::size_t oldestSample{ fpsCounter.getOldestSample() };
+    const float barWidth{ graphSize.x / FpsCounter::windowSize };
+
+    // Samples are drawn oldest first, so the newest frame is at the right edge.
+    for (std::size_t i{}; i < frameTimes.size(); ++i) {
+        const float frameTime{ frameTimes[(oldestSample + i) % frameTimes.size()] };
+        const float height{ std::min(frameTime / graphScaleMs, 1.f) * graphSize.y };
+        const float x{ graphBottomRight.x - (frameTimes.size() - i) * barWidth };
+
+        drawList->AddRectFilled(
+            { x, graphBottomRight.y - height },
+            { x + barWidth, graphBottomRight.y },
+            frameTime > targetFrameTimeMs ? IM_COL32(255, 127, 0, 255) : IM_COL32(0, 255, 0, 255)
+        );
+    }
+
+    const float targetY{ graphBottomRight.y - targetFrameTimeMs / graphScaleMs * graphSize.y };
+    drawList->AddLine({ graphTopLeft.x, targetY }, { graphBottomRight.x, targetY }, IM_COL32(255, 255, 255, 127));
+    drawList->AddRect(graphTopLeft, graphBottomRight, IM_COL32_WHITE);
+
+    topRight.y = graphBottomRight.y + spacing;
+}
+
+/**
+ * @brief Draws the allocations of the latest frame, the zones allocating the most
+ *        by themselves and the allocations made while forbidden right-aligned below a point.
+ */
+static void drawAllocations(ImVec2 topRight, ImDrawList* const drawList) {
+    constexpr std::size_t shownZoneCount{ 3 };
+    constexpr ImU32 violationColor{ IM_COL32(255, 0, 0, 255) };
+
+    HudText text{};
+    std::array<AllocationTracker::ZoneCounts, shownZoneCount> zones{};
+
+    const AllocationCounts frameCounts{ AllocationTracker::getFrameCounts() };
+    drawRightAligned(formatText(text, "{} allocations, {:.1f} KiB per frame", frameCounts.count, frameCounts.bytes / 1024.0),
+        IM_COL32_WHITE, topRight, drawList);
+
+    const std::size_t zoneCount{ AllocationTracker::copyFrameZones(zones) };
+    for (std::size_t i{}; i < zoneCount; ++i) {
+        drawRightAligned(formatText(text, "{}: {}", zones[i].name ? zones[i].name : "No zone", zones[i].counts.count),
+            IM_COL32_WHITE, topRight, drawList);
+    }
+
+    if (const AllocationCounts dropped{ AllocationTracker::getDroppedFrameCounts() }; dropped.count > 0) {
+        drawRightAligned(formatText(text, "Zones beyond the table: {}", dropped.count), IM_COL32_WHITE, topRight, drawList);
+    }
+
+    const AllocationCounts violationCounts{ AllocationTracker::getViolationCounts() };
+    if (violationCounts.count == 0) {
+        return;
+    }
+
+    drawRightAligned(formatText(text, "{} forbidden allocations", violationCounts.count), violationColor, topRight, drawList);
+
+    const std::size_t violationZoneCount{ AllocationTracker::copyViolations(zones) };
+    for (std::size_t i{}; i < violationZoneCount; ++i) {
+        drawRightAligned(formatText(text, "{}: {}", zones[i].name ? zones[i].name : "No zone", zones[i].counts.count),
+            violationColor, topRight, drawList);
+    }
+
+    if (const AllocationCounts dropped{ AllocationTracker::getDroppedViolationCounts() }; dropped.count > 0) {
+        drawRightAligned(formatText(text, "Zones beyond the table: {}", dropped.count), violationColor, topRight, drawList);
+    }
+}
 
 void ui::drawHud(Game& game, const double dt) {
     const ImGuiViewport* const mainViewport{ ImGui::GetMainViewport() };
@@ -17,13 +143,12 @@ void ui::drawHud(Game& game, const double dt) {
     constexpr float padding{ 10.f };
 
     if (game.getSettings().showFps) {
-        const std::string fpsText{ std::format("{:.2f} FPS", game.getFps()) };
+        ImVec2 topRight{ mainViewport->WorkSize.x - padding, padding };
+        drawFrameTimes(game.getFpsCounter(), game.getGpuTimings(), topRight, drawList);
 
-        drawList->AddText(
-            { mainViewport->WorkSize.x - ImGui::CalcTextSize(fpsText.c_str()).x - padding, padding },
-            IM_COL32_WHITE,
-            fpsText.c_str()
-        );
+        if constexpr (AllocationTracker::isEnabled) {
+            drawAllocations(topRight, drawList);
+        }
     }
 
     static auto previousLevel{ game.getCurrentLevel() };
@@ -35,35 +160,36 @@ void ui::drawHud(Game& game, const double dt) {
     }
     previousLevel = currentLevel;
 
-    const std::string levelText{ std::format("Level {}", currentLevel) };
+    HudText levelText{};
+    formatText(levelText, "Level {}", currentLevel);
     if (zoomedLevelTime > 0.0) {
         zoomedLevelTime -= dt;
 
         ImGui::PushFont(NULL, 50.f);
-        const ImVec2 levelTextSize{ ImGui::CalcTextSize(levelText.c_str()) };
+        const ImVec2 levelTextSize{ ImGui::CalcTextSize(levelText.data()) };
         drawList->AddText(
             {
                 (mainViewport->WorkSize.x - levelTextSize.x) / 2.f,
                 (mainViewport->WorkSize.y - levelTextSize.y) / 2.f,
             },
             IM_COL32_WHITE,
-            levelText.c_str()
+            levelText.data()
         );
     } else {
         ImGui::PushFont(NULL, 25.f);
         drawList->AddText(
             {
-                (mainViewport->WorkSize.x - ImGui::CalcTextSize(levelText.c_str()).x) / 2.f,
+                (mainViewport->WorkSize.x - ImGui::CalcTextSize(levelText.data()).x) / 2.f,
                 padding
             },
             IM_COL32_WHITE,
-            levelText.c_str()
+            levelText.data()
         );
     }
 
     ImGui::PopFont();
 
-    const Health playerHealth{ getPlayerHealth(game.getRegistry()) };
+    const Health playerHealth{ game.getSnapshot().playerHealth };
     const float healthPercentage{ std::clamp(static_cast<float>(playerHealth.current) / playerHealth.max, 0.f, 1.f) };
     ImU32 healthColor{};
     switch (std::lround(healthPercentage * 3)) {
@@ -75,8 +201,9 @@ void ui::drawHud(Game& game, const double dt) {
 
     ImGui::PushFont(NULL, 25.f);
 
-    const std::string hpText{ std::format("Health: {}", playerHealth.current) };
-    const ImVec2 hpTextSize{ ImGui::CalcTextSize(hpText.c_str()) };
+    HudText hpText{};
+    formatText(hpText, "Health: {}", playerHealth.current);
+    const ImVec2 hpTextSize{ ImGui::CalcTextSize(hpText.data()) };
     const ImVec2 hpBoxTopLeft{
         (mainViewport->WorkSize.x - hpTextSize.x) / 2.f,
         mainViewport->WorkSize.y - hpTextSize.y - padding * 3
@@ -85,7 +212,7 @@ void ui::drawHud(Game& game, const double dt) {
     drawList->AddText(
         hpBoxTopLeft,
         healthColor,
-        hpText.c_str()
+        hpText.data()
     );
 
     ImGui::PopFont();
@@ -1,5 +1,7 @@
 #include "ui-core.h"
 
+#include <core/profiler.h>
+
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
@@ -8,12 +10,14 @@
 namespace ui {
 
 void beginFrame() {
+    PROFILE_ZONE("ImGui::NewFrame");
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 }
 
 void endFrame() {
+    PROFILE_ZONE("ImGui::Render");
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
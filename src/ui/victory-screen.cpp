@@ -1,6 +1,6 @@
 #include "victory-screen.h"
 
-#include <ecs/queries.h>
+#include <ecs/render-snapshot.h>
 #include <gameplay/game.h>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
@@ -42,7 +42,7 @@ void ui::drawVictoryScreen(Game& game) {
     ImGui::PopFont();
     ImGui::PushFont(NULL, 20.f);
 
-    const Stats playerStats{ getPlayerStats(game.getRegistry()) };
+    const Stats playerStats{ game.getSnapshot().playerStats };
     using namespace std::string_literals;
     const auto formattedStats{ std::array{
         "Congratulations, all invaders were DESTROYED!"s,